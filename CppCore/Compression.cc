@@ -0,0 +1,444 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <streambuf>
+#include <utility>
+#include <vector>
+
+#include "readCon/include/Compression.hpp"
+
+#ifdef WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef WITH_LZMA
+#include <lzma.h>
+#endif
+#ifdef WITH_ZSTD
+#include <zstd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace yodecon::compression {
+namespace {
+constexpr size_t ChunkSize{size_t{1} << 16};
+
+// Outcome of a single decoding call
+struct Step {
+  size_t consumed{0};
+  size_t produced{0};
+  bool finished{false}; // A complete compressed stream (member) has ended
+};
+
+// Incremental decoder for one codec, fed arbitrary slices of the input
+class Decoder {
+public:
+  virtual ~Decoder() = default;
+  //! a_last is set once a_in holds everything left of the input
+  virtual Step decode(std::string_view a_in, char *a_out, size_t a_cap,
+                      bool a_last) = 0;
+  //! Prepares for a further concatenated member
+  virtual void reset() = 0;
+};
+
+#ifdef WITH_ZLIB
+// zlib counts in 32 bit uInt, larger spans are handed over in pieces
+uInt clamp_avail(size_t a_size) {
+  return static_cast<uInt>(
+      std::min<size_t>(a_size, std::numeric_limits<uInt>::max()));
+}
+
+class GzipDecoder : public Decoder {
+public:
+  GzipDecoder() {
+    // 32 enables gzip header detection
+    if (inflateInit2(&m_strm, 15 + 32) != Z_OK) {
+      throw std::runtime_error("Failed to initialize the gzip decoder");
+    }
+  }
+  ~GzipDecoder() override { inflateEnd(&m_strm); }
+  GzipDecoder(const GzipDecoder &) = delete;
+  GzipDecoder &operator=(const GzipDecoder &) = delete;
+
+  Step decode(std::string_view a_in, char *a_out, size_t a_cap,
+              bool /*a_last*/) override {
+    m_strm.next_in =
+        reinterpret_cast<Bytef *>(const_cast<char *>(a_in.data()));
+    const uInt nin = clamp_avail(a_in.size());
+    const uInt nout = clamp_avail(a_cap);
+    m_strm.avail_in = nin;
+    m_strm.next_out = reinterpret_cast<Bytef *>(a_out);
+    m_strm.avail_out = nout;
+    const int ret = inflate(&m_strm, Z_NO_FLUSH);
+    if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) {
+      throw std::runtime_error("Corrupt gzip input");
+    }
+    // Callers loop until finished, so a clamped call is merely a short step
+    return {size_t{nin} - m_strm.avail_in, size_t{nout} - m_strm.avail_out,
+            ret == Z_STREAM_END};
+  }
+  void reset() override { inflateReset(&m_strm); }
+
+private:
+  z_stream m_strm{};
+};
+#endif
+
+#ifdef WITH_LZMA
+class XzDecoder : public Decoder {
+public:
+  explicit XzDecoder(bool a_concatenated) {
+    if (lzma_stream_decoder(&m_strm, UINT64_MAX,
+                            a_concatenated ? LZMA_CONCATENATED : 0) !=
+        LZMA_OK) {
+      throw std::runtime_error("Failed to initialize the xz decoder");
+    }
+  }
+  ~XzDecoder() override { lzma_end(&m_strm); }
+  XzDecoder(const XzDecoder &) = delete;
+  XzDecoder &operator=(const XzDecoder &) = delete;
+
+  Step decode(std::string_view a_in, char *a_out, size_t a_cap,
+              bool a_last) override {
+    m_strm.next_in = reinterpret_cast<const uint8_t *>(a_in.data());
+    m_strm.avail_in = a_in.size();
+    m_strm.next_out = reinterpret_cast<uint8_t *>(a_out);
+    m_strm.avail_out = a_cap;
+    // Concatenated streams only end once the decoder is told no more follow
+    const lzma_ret ret = lzma_code(&m_strm, a_last ? LZMA_FINISH : LZMA_RUN);
+    if (ret != LZMA_OK && ret != LZMA_STREAM_END && ret != LZMA_BUF_ERROR) {
+      throw std::runtime_error("Corrupt xz input");
+    }
+    return {a_in.size() - m_strm.avail_in, a_cap - m_strm.avail_out,
+            ret == LZMA_STREAM_END};
+  }
+  // Only used with LZMA_CONCATENATED, which decodes every member as one
+  void reset() override {}
+
+private:
+  lzma_stream m_strm = LZMA_STREAM_INIT;
+};
+#endif
+
+#ifdef WITH_ZSTD
+class ZstdDecoder : public Decoder {
+public:
+  ZstdDecoder() : m_ctx{ZSTD_createDCtx()} {
+    if (m_ctx == nullptr) {
+      throw std::runtime_error("Failed to initialize the zstd decoder");
+    }
+  }
+  ~ZstdDecoder() override { ZSTD_freeDCtx(m_ctx); }
+  ZstdDecoder(const ZstdDecoder &) = delete;
+  ZstdDecoder &operator=(const ZstdDecoder &) = delete;
+
+  Step decode(std::string_view a_in, char *a_out, size_t a_cap,
+              bool /*a_last*/) override {
+    ZSTD_inBuffer input{a_in.data(), a_in.size(), 0};
+    ZSTD_outBuffer output{a_out, a_cap, 0};
+    const size_t ret = ZSTD_decompressStream(m_ctx, &output, &input);
+    if (ZSTD_isError(ret) != 0) {
+      throw std::runtime_error(std::string{"Corrupt zstd input: "} +
+                               ZSTD_getErrorName(ret));
+    }
+    // Zero once a frame has been fully decoded and flushed
+    return {input.pos, output.pos, ret == 0};
+  }
+  // Frames follow one another without resetting the context
+  void reset() override {}
+
+private:
+  ZSTD_DCtx *m_ctx;
+};
+#endif
+
+[[noreturn]] void unsupported(Codec a_codec) {
+  throw std::runtime_error(std::string{"Support for "} +
+                           std::string{codec_name(a_codec)} +
+                           " was not enabled at build time");
+}
+
+// a_concatenated asks for a decoder which continues into following members
+std::unique_ptr<Decoder> make_decoder(Codec a_codec, bool a_concatenated) {
+  switch (a_codec) {
+#ifdef WITH_ZLIB
+  case Codec::Gzip:
+    return std::make_unique<GzipDecoder>();
+#endif
+#ifdef WITH_LZMA
+  case Codec::Xz:
+    return std::make_unique<XzDecoder>(a_concatenated);
+#endif
+#ifdef WITH_ZSTD
+  case Codec::Zstd:
+    return std::make_unique<ZstdDecoder>();
+#endif
+  default:
+    unsupported(a_codec);
+  }
+}
+
+// Pulls compressed chunks from the source and hands out decoded ones
+class DecompressingBuf : public std::streambuf {
+public:
+  DecompressingBuf(std::istream &a_source, Codec a_codec)
+      : m_source{a_source}, m_decoder{make_decoder(a_codec, true)},
+        m_in(ChunkSize), m_out(ChunkSize) {
+    setg(m_out.data(), m_out.data(), m_out.data());
+  }
+
+protected:
+  int_type underflow() override {
+    while (gptr() == egptr()) {
+      if (m_in_begin == m_in_end && !m_source_done) {
+        refill();
+      }
+      const std::string_view pending{m_in.data() + m_in_begin,
+                                     m_in_end - m_in_begin};
+      if (pending.empty() && m_source_done && m_member_done) {
+        return traits_type::eof();
+      }
+      if (m_member_done) {
+        // Another member follows the one which just ended
+        m_decoder->reset();
+        m_member_done = false;
+      }
+      const Step step =
+          m_decoder->decode(pending, m_out.data(), m_out.size(), m_source_done);
+      m_in_begin += step.consumed;
+      m_member_done = step.finished;
+      setg(m_out.data(), m_out.data(), m_out.data() + step.produced);
+      if (step.consumed == 0 && step.produced == 0 && !step.finished &&
+          m_source_done) {
+        throw std::runtime_error("Compressed input ends unexpectedly");
+      }
+    }
+    return traits_type::to_int_type(*gptr());
+  }
+
+private:
+  void refill() {
+    m_source.read(m_in.data(), static_cast<std::streamsize>(m_in.size()));
+    m_in_begin = 0;
+    m_in_end = static_cast<size_t>(m_source.gcount());
+    m_source_done = m_source.eof();
+    if (m_source.bad()) {
+      throw std::runtime_error("Failed to read the compressed input");
+    }
+  }
+
+  std::istream &m_source;
+  std::unique_ptr<Decoder> m_decoder;
+  std::vector<char> m_in;
+  std::vector<char> m_out;
+  size_t m_in_begin{0};
+  size_t m_in_end{0};
+  bool m_source_done{false};
+  bool m_member_done{false};
+};
+
+// Owns the decoding buffer and optionally the compressed file it reads
+class DecompressingStream : public std::istream {
+public:
+  DecompressingStream(std::unique_ptr<std::istream> a_owned,
+                      std::istream &a_source, Codec a_codec)
+      : std::istream{nullptr}, m_owned{std::move(a_owned)},
+        m_buf{a_source, a_codec} {
+    rdbuf(&m_buf);
+    // Rethrow decoding errors rather than reporting them as end of input
+    exceptions(std::ios::badbit);
+  }
+
+private:
+  std::unique_ptr<std::istream> m_owned;
+  DecompressingBuf m_buf;
+};
+} // namespace
+
+Codec detect_codec(std::string_view a_head) noexcept {
+  auto starts_with = [&](std::string_view a_magic) {
+    return a_head.substr(0, a_magic.size()) == a_magic;
+  };
+  using namespace std::string_view_literals;
+  if (starts_with("\x1f\x8b"sv)) {
+    return Codec::Gzip;
+  }
+  if (starts_with("\xfd" "7zXZ\x00"sv)) {
+    return Codec::Xz;
+  }
+  if (starts_with("\x28\xb5\x2f\xfd"sv)) {
+    return Codec::Zstd;
+  }
+  return Codec::None;
+}
+
+Codec detect_codec_of(const std::string &a_fname) {
+  if (!fs::exists(a_fname)) {
+    throw std::runtime_error("File not found");
+  }
+  std::ifstream ifs{a_fname, std::ios::binary};
+  if (!ifs.is_open()) {
+    throw std::runtime_error("Failed to open the file");
+  }
+  std::array<char, MagicLength> head{};
+  ifs.read(head.data(), head.size());
+  return detect_codec({head.data(), static_cast<size_t>(ifs.gcount())});
+}
+
+bool is_supported(Codec a_codec) noexcept {
+  switch (a_codec) {
+  case Codec::None:
+    return true;
+  case Codec::Gzip:
+#ifdef WITH_ZLIB
+    return true;
+#else
+    return false;
+#endif
+  case Codec::Xz:
+#ifdef WITH_LZMA
+    return true;
+#else
+    return false;
+#endif
+  case Codec::Zstd:
+#ifdef WITH_ZSTD
+    return true;
+#else
+    return false;
+#endif
+  }
+  return false;
+}
+
+std::string_view codec_name(Codec a_codec) noexcept {
+  switch (a_codec) {
+  case Codec::None:
+    return "uncompressed";
+  case Codec::Gzip:
+    return "gzip";
+  case Codec::Xz:
+    return "xz";
+  case Codec::Zstd:
+    return "zstd";
+  }
+  return "unknown";
+}
+
+std::unique_ptr<std::istream> decompress(std::istream &a_source,
+                                         Codec a_codec) {
+  return std::make_unique<DecompressingStream>(nullptr, a_source, a_codec);
+}
+
+std::string compress(std::string_view a_data, Codec a_codec) {
+  std::string out;
+  switch (a_codec) {
+#ifdef WITH_ZLIB
+  case Codec::Gzip: {
+    z_stream strm{};
+    // 16 selects the gzip wrapper
+    if (deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+      throw std::runtime_error("Failed to initialize the gzip encoder");
+    }
+    // Exact for inputs below 4 GiB, larger outputs grow as needed
+    out.resize(deflateBound(&strm, clamp_avail(a_data.size())));
+    strm.next_in =
+        reinterpret_cast<Bytef *>(const_cast<char *>(a_data.data()));
+    size_t in_left{a_data.size()};
+    size_t out_pos{0};
+    int ret{Z_OK};
+    while (ret != Z_STREAM_END) {
+      if (strm.avail_in == 0) {
+        strm.avail_in = clamp_avail(in_left);
+        in_left -= strm.avail_in;
+      }
+      if (out_pos == out.size()) {
+        out.resize(2 * out.size());
+      }
+      const uInt nout = clamp_avail(out.size() - out_pos);
+      strm.next_out = reinterpret_cast<Bytef *>(out.data() + out_pos);
+      strm.avail_out = nout;
+      ret = deflate(&strm, in_left == 0 ? Z_FINISH : Z_NO_FLUSH);
+      out_pos += nout - strm.avail_out;
+      if (ret != Z_OK && ret != Z_BUF_ERROR && ret != Z_STREAM_END) {
+        deflateEnd(&strm);
+        throw std::runtime_error("Failed to compress with gzip");
+      }
+    }
+    deflateEnd(&strm);
+    out.resize(out_pos);
+    return out;
+  }
+#endif
+#ifdef WITH_LZMA
+  case Codec::Xz: {
+    out.resize(lzma_stream_buffer_bound(a_data.size()));
+    size_t out_pos{0};
+    if (lzma_easy_buffer_encode(
+            LZMA_PRESET_DEFAULT, LZMA_CHECK_CRC64, nullptr,
+            reinterpret_cast<const uint8_t *>(a_data.data()), a_data.size(),
+            reinterpret_cast<uint8_t *>(out.data()), &out_pos,
+            out.size()) != LZMA_OK) {
+      throw std::runtime_error("Failed to compress with xz");
+    }
+    out.resize(out_pos);
+    return out;
+  }
+#endif
+#ifdef WITH_ZSTD
+  case Codec::Zstd: {
+    out.resize(ZSTD_compressBound(a_data.size()));
+    const size_t nbytes =
+        ZSTD_compress(out.data(), out.size(), a_data.data(), a_data.size(),
+                      ZSTD_CLEVEL_DEFAULT);
+    if (ZSTD_isError(nbytes) != 0) {
+      throw std::runtime_error(std::string{"Failed to compress with zstd: "} +
+                               ZSTD_getErrorName(nbytes));
+    }
+    out.resize(nbytes);
+    return out;
+  }
+#endif
+  default:
+    unsupported(a_codec);
+  }
+}
+
+size_t decompress_member(std::string_view a_in, Codec a_codec,
+                         std::string &a_out) {
+  auto decoder = make_decoder(a_codec, false);
+  std::vector<char> chunk(ChunkSize);
+  size_t consumed{0};
+  while (true) {
+    const Step step = decoder->decode(a_in.substr(consumed), chunk.data(),
+                                      chunk.size(), true);
+    consumed += step.consumed;
+    a_out.append(chunk.data(), step.produced);
+    if (step.finished) {
+      return consumed;
+    }
+    if (step.consumed == 0 && step.produced == 0) {
+      throw std::runtime_error("Compressed input ends unexpectedly");
+    }
+  }
+}
+
+std::unique_ptr<std::istream> open_input(const std::string &a_fname) {
+  const Codec codec = detect_codec_of(a_fname);
+  auto file = std::make_unique<std::ifstream>(a_fname, std::ios::binary);
+  if (!file->is_open()) {
+    throw std::runtime_error("Failed to open the file");
+  }
+  if (codec == Codec::None) {
+    return file;
+  }
+  std::istream &source = *file;
+  return std::make_unique<DecompressingStream>(std::move(file), source, codec);
+}
+} // namespace yodecon::compression
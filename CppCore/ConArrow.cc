@@ -1,9 +1,374 @@
 // MIT License
 // Copyright 2023--present Rohit Goswami <HaoZeke>
-#ifdef WITH_ARROW
 #include "readCon/include/ConArrow.hpp"
 
+#ifdef WITH_APACHE_ARROW
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include <arrow/io/file.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/ipc/writer.h>
+
 namespace yodecon::conarrow {
+namespace {
+// Shortest text which reads back as the same double, unlike the 6 digits of
+// to_csv_string
+template <typename Container>
+std::string to_exact_csv(const Container &a_values) {
+  std::string result;
+  char buf[32];
+  for (const double value : a_values) {
+    if (!result.empty()) {
+      result += ',';
+    }
+    auto res = std::to_chars(buf, buf + sizeof(buf), value);
+    result.append(buf, res.ptr);
+  }
+  return result;
+}
+
+template <typename ConFrameLike>
+std::shared_ptr<arrow::KeyValueMetadata>
+frame_metadata(const ConFrameLike &a_frame) {
+  std::vector<std::string> keys = {
+      "prebox_header", "boxl",           "angles",         "postbox_header",
+      "natm_types",    "natms_per_type", "masses_per_type"};
+
+  std::vector<std::string> values = {
+      yodecon::helpers::string::to_csv_string(a_frame.prebox_header),
+      to_exact_csv(a_frame.boxl),
+      to_exact_csv(a_frame.angles),
+      yodecon::helpers::string::to_csv_string(a_frame.postbox_header),
+      std::to_string(a_frame.natm_types),
+      yodecon::helpers::string::to_csv_string(a_frame.natms_per_type),
+      to_exact_csv(a_frame.masses_per_type)};
+
+  return std::make_shared<arrow::KeyValueMetadata>(keys, values);
+}
+
+// Hands the storage of `a_values` over to Arrow, nothing is copied
+template <typename T>
+std::shared_ptr<arrow::Array> wrap_vector(std::vector<T> &&a_values) {
+  using ArrowType = typename arrow::CTypeTraits<T>::ArrowType;
+  const auto length = static_cast<int64_t>(a_values.size());
+  return std::make_shared<arrow::NumericArray<ArrowType>>(
+      length, arrow::Buffer::FromVector(std::move(a_values)));
+}
+
+// Distinct symbols of `a_symbols`, in order of appearance
+void collect_symbols(const std::vector<std::string> &a_symbols,
+                     std::vector<std::string> &a_distinct) {
+  const std::string *previous{nullptr};
+  for (const auto &symbol : a_symbols) {
+    // Symbols come in runs, one per component, so lookups are rare
+    if (previous == nullptr || symbol != *previous) {
+      if (std::find(a_distinct.begin(), a_distinct.end(), symbol) ==
+          a_distinct.end()) {
+        a_distinct.push_back(symbol);
+      }
+      previous = &symbol;
+    }
+  }
+}
+
+std::shared_ptr<arrow::Array>
+make_dictionary(const std::vector<std::string> &a_distinct) {
+  arrow::StringBuilder dictBuilder;
+  CHECK_ARROW_STATUS(dictBuilder.AppendValues(a_distinct));
+  std::shared_ptr<arrow::Array> dictionary;
+  CHECK_ARROW_STATUS(dictBuilder.Finish(&dictionary));
+  return dictionary;
+}
+
+// Dictionary column over `a_dictionary`, built from `a_distinct`, which must
+// hold every symbol
+std::shared_ptr<arrow::Array>
+encode_symbols(const std::vector<std::string> &a_symbols,
+               const std::vector<std::string> &a_distinct,
+               const std::shared_ptr<arrow::Array> &a_dictionary) {
+  std::vector<int32_t> indices(a_symbols.size());
+  size_t current{0};
+  for (size_t idx{0}; idx < a_symbols.size(); idx++) {
+    if (a_symbols[idx] != a_distinct[current]) {
+      current = static_cast<size_t>(
+          std::find(a_distinct.begin(), a_distinct.end(), a_symbols[idx]) -
+          a_distinct.begin());
+    }
+    indices[idx] = static_cast<int32_t>(current);
+  }
+  return std::make_shared<arrow::DictionaryArray>(
+      arrow::dictionary(arrow::int32(), arrow::utf8()),
+      wrap_vector(std::move(indices)), a_dictionary);
+}
+
+std::shared_ptr<arrow::Array> pack_flags(const std::vector<bool> &a_flags) {
+  const auto length = static_cast<int64_t>(a_flags.size());
+  auto bitmap = arrow::AllocateEmptyBitmap(length);
+  CHECK_ARROW_STATUS(bitmap.status());
+  // Arrow bitmaps are least significant bit first, set by hand since the
+  // bit_util helpers are internal and have been renamed between releases
+  uint8_t *bits = (*bitmap)->mutable_data();
+  for (size_t idx{0}; idx < a_flags.size(); idx++) {
+    if (a_flags[idx]) {
+      bits[idx / 8] |= static_cast<uint8_t>(1U << (idx % 8));
+    }
+  }
+  return std::make_shared<arrow::BooleanArray>(length, *bitmap);
+}
+
+template <typename Real>
+std::vector<std::shared_ptr<arrow::Field>> atom_fields() {
+  auto real_type = arrow::CTypeTraits<Real>::type_singleton();
+  return {
+      arrow::field("symbol", arrow::dictionary(arrow::int32(), arrow::utf8())),
+      arrow::field("x", real_type),
+      arrow::field("y", real_type),
+      arrow::field("z", real_type),
+      arrow::field("is_fixed", arrow::boolean()),
+      arrow::field("atom_id", arrow::int32())};
+}
+
+template <typename Real>
+void check_columns(const yodecon::types::BasicConFrameVec<Real> &a_frame) {
+  const size_t natoms = a_frame.x.size();
+  if (a_frame.y.size() != natoms || a_frame.z.size() != natoms ||
+      a_frame.symbol.size() != natoms || a_frame.is_fixed.size() != natoms ||
+      a_frame.atom_id.size() != natoms) {
+    throw std::invalid_argument("The atom columns differ in length");
+  }
+}
+
+// Columns of atom_fields(), the numeric ones moved out of `a_frame`
+template <typename Real>
+std::vector<std::shared_ptr<arrow::Array>>
+atom_arrays(yodecon::types::BasicConFrameVec<Real> &a_frame,
+            const std::vector<std::string> &a_distinct,
+            const std::shared_ptr<arrow::Array> &a_dictionary) {
+  std::vector<std::shared_ptr<arrow::Array>> array_vector = {
+      encode_symbols(a_frame.symbol, a_distinct, a_dictionary),
+      wrap_vector(std::move(a_frame.x)),
+      wrap_vector(std::move(a_frame.y)),
+      wrap_vector(std::move(a_frame.z)),
+      pack_flags(a_frame.is_fixed),
+      wrap_vector(std::move(a_frame.atom_id))};
+  a_frame.symbol.clear();
+  a_frame.is_fixed.clear();
+  return array_vector;
+}
+
+template <typename Real>
+std::shared_ptr<arrow::Table>
+convert_vec(yodecon::types::BasicConFrameVec<Real> &&a_frame) {
+  check_columns(a_frame);
+  const auto natoms = static_cast<int64_t>(a_frame.x.size());
+  std::vector<std::string> distinct;
+  collect_symbols(a_frame.symbol, distinct);
+  auto schema = arrow::schema(atom_fields<Real>(), frame_metadata(a_frame));
+  return arrow::Table::Make(
+      schema, atom_arrays(a_frame, distinct, make_dictionary(distinct)),
+      natoms);
+}
+
+// List column with rows `a_values[a_offsets[i]:a_offsets[i + 1]]`
+std::shared_ptr<arrow::Array>
+list_column(std::vector<int32_t> &&a_offsets,
+            const std::shared_ptr<arrow::Array> &a_values) {
+  const auto length = static_cast<int64_t>(a_offsets.size()) - 1;
+  return std::make_shared<arrow::ListArray>(
+      arrow::list(a_values->type()), length,
+      arrow::Buffer::FromVector(std::move(a_offsets)), a_values);
+}
+
+template <typename Real>
+std::shared_ptr<arrow::Table> cell_table(
+    const std::vector<yodecon::types::BasicConFrameVec<Real>> &a_frames) {
+  const size_t nframes = a_frames.size();
+  std::vector<int64_t> frame(nframes), natoms(nframes);
+  std::vector<std::vector<double>> cell(6, std::vector<double>(nframes));
+  std::vector<int64_t> natm_types(nframes);
+  std::vector<uint64_t> natms_per_type;
+  std::vector<double> masses_per_type;
+  std::vector<int32_t> type_offsets{0}, line_offsets{0};
+  arrow::StringBuilder prebox, postbox;
+  for (size_t idx{0}; idx < nframes; idx++) {
+    const auto &current = a_frames[idx];
+    frame[idx] = static_cast<int64_t>(idx);
+    natoms[idx] = static_cast<int64_t>(current.x.size());
+    for (size_t dim{0}; dim < 3; dim++) {
+      cell[dim][idx] = current.boxl[dim];
+      cell[dim + 3][idx] = current.angles[dim];
+    }
+    if (current.natms_per_type.size() != current.natm_types ||
+        current.masses_per_type.size() != current.natm_types) {
+      throw std::invalid_argument(
+          "natms_per_type and masses_per_type need an entry per component");
+    }
+    natm_types[idx] = static_cast<int64_t>(current.natm_types);
+    natms_per_type.insert(natms_per_type.end(),
+                          current.natms_per_type.begin(),
+                          current.natms_per_type.end());
+    masses_per_type.insert(masses_per_type.end(),
+                           current.masses_per_type.begin(),
+                           current.masses_per_type.end());
+    type_offsets.push_back(static_cast<int32_t>(natms_per_type.size()));
+    for (size_t line{0}; line < 2; line++) {
+      CHECK_ARROW_STATUS(prebox.Append(current.prebox_header[line]));
+      CHECK_ARROW_STATUS(postbox.Append(current.postbox_header[line]));
+    }
+    line_offsets.push_back(line_offsets.back() + 2);
+  }
+  std::shared_ptr<arrow::Array> prebox_lines, postbox_lines;
+  CHECK_ARROW_STATUS(prebox.Finish(&prebox_lines));
+  CHECK_ARROW_STATUS(postbox.Finish(&postbox_lines));
+  auto schema = arrow::schema({arrow::field("frame", arrow::int64()),
+                               arrow::field("natoms", arrow::int64()),
+                               arrow::field("a", arrow::float64()),
+                               arrow::field("b", arrow::float64()),
+                               arrow::field("c", arrow::float64()),
+                               arrow::field("alpha", arrow::float64()),
+                               arrow::field("beta", arrow::float64()),
+                               arrow::field("gamma", arrow::float64()),
+                               arrow::field("natm_types", arrow::int64()),
+                               arrow::field("natms_per_type",
+                                            arrow::list(arrow::uint64())),
+                               arrow::field("masses_per_type",
+                                            arrow::list(arrow::float64())),
+                               arrow::field("prebox_header",
+                                            arrow::list(arrow::utf8())),
+                               arrow::field("postbox_header",
+                                            arrow::list(arrow::utf8()))});
+  std::vector<std::shared_ptr<arrow::Array>> array_vector = {
+      wrap_vector(std::move(frame)), wrap_vector(std::move(natoms))};
+  for (auto &column : cell) {
+    array_vector.push_back(wrap_vector(std::move(column)));
+  }
+  array_vector.push_back(wrap_vector(std::move(natm_types)));
+  array_vector.push_back(list_column(std::vector<int32_t>{type_offsets},
+                                     wrap_vector(std::move(natms_per_type))));
+  array_vector.push_back(list_column(std::move(type_offsets),
+                                     wrap_vector(std::move(masses_per_type))));
+  array_vector.push_back(
+      list_column(std::vector<int32_t>{line_offsets}, prebox_lines));
+  array_vector.push_back(list_column(std::move(line_offsets), postbox_lines));
+  return arrow::Table::Make(schema, array_vector,
+                            static_cast<int64_t>(nframes));
+}
+
+std::string_view metadata_value(const arrow::KeyValueMetadata &a_metadata,
+                                const std::string &a_key) {
+  const int idx = a_metadata.FindKey(a_key);
+  if (idx < 0) {
+    throw std::invalid_argument("The batch carries no frame header");
+  }
+  return a_metadata.value(idx);
+}
+
+template <typename T>
+std::vector<T> parse_csv(std::string_view a_values) {
+  std::vector<T> result;
+  while (!a_values.empty()) {
+    const size_t comma = std::min(a_values.find(','), a_values.size());
+    T value{};
+    if (!yodecon::helpers::string::parse_token(a_values.substr(0, comma),
+                                               value)) {
+      throw std::invalid_argument("Malformed frame header metadata");
+    }
+    result.push_back(value);
+    a_values.remove_prefix(std::min(comma + 1, a_values.size()));
+  }
+  return result;
+}
+
+std::array<double, 3> parse_triple(std::string_view a_values) {
+  const auto values = parse_csv<double>(a_values);
+  if (values.size() != 3) {
+    throw std::invalid_argument("Malformed frame header metadata");
+  }
+  return {values[0], values[1], values[2]};
+}
+
+std::array<std::string, 2> split_lines(std::string_view a_lines) {
+  const size_t comma = a_lines.find(',');
+  if (comma == std::string_view::npos) {
+    throw std::invalid_argument("Malformed frame header metadata");
+  }
+  return {std::string{a_lines.substr(0, comma)},
+          std::string{a_lines.substr(comma + 1)}};
+}
+
+template <typename ArrayT>
+std::shared_ptr<ArrayT> column_as(const arrow::RecordBatch &a_batch,
+                                  const std::string &a_name,
+                                  const arrow::DataType &a_type) {
+  auto column = a_batch.GetColumnByName(a_name);
+  if (!column || !column->type()->Equals(a_type)) {
+    throw std::invalid_argument("Missing or mistyped column " + a_name);
+  }
+  if (column->null_count() != 0) {
+    throw std::invalid_argument("Nulls in column " + a_name);
+  }
+  return std::static_pointer_cast<ArrayT>(column);
+}
+// Row `a_row` of column `a_name` of `a_cells`, as the chunk holding it and
+// the index within that chunk
+template <typename ArrayT>
+std::pair<std::shared_ptr<ArrayT>, int64_t>
+cell_at(const arrow::Table &a_cells, const std::string &a_name,
+        const arrow::DataType &a_type, int64_t a_row) {
+  auto column = a_cells.GetColumnByName(a_name);
+  if (!column || !column->type()->Equals(a_type)) {
+    throw std::invalid_argument("Missing or mistyped column " + a_name);
+  }
+  for (const auto &chunk : column->chunks()) {
+    if (a_row < chunk->length()) {
+      if (chunk->IsNull(a_row)) {
+        throw std::invalid_argument("Nulls in column " + a_name);
+      }
+      return {std::static_pointer_cast<ArrayT>(chunk), a_row};
+    }
+    a_row -= chunk->length();
+  }
+  throw std::out_of_range("Row past the end of column " + a_name);
+}
+
+double cell_double(const arrow::Table &a_cells, const std::string &a_name,
+                   int64_t a_row) {
+  const auto [column, idx] =
+      cell_at<arrow::DoubleArray>(a_cells, a_name, *arrow::float64(), a_row);
+  return column->Value(idx);
+}
+
+// Values of the list in row `a_row` of column `a_name`
+template <typename ArrayT>
+std::shared_ptr<ArrayT>
+cell_list(const arrow::Table &a_cells, const std::string &a_name,
+          const std::shared_ptr<arrow::DataType> &a_value_type,
+          int64_t a_row) {
+  const auto [column, idx] = cell_at<arrow::ListArray>(
+      a_cells, a_name, *arrow::list(a_value_type), a_row);
+  auto values = column->value_slice(idx);
+  if (values->null_count() != 0) {
+    throw std::invalid_argument("Nulls in column " + a_name);
+  }
+  return std::static_pointer_cast<ArrayT>(values);
+}
+
+std::array<std::string, 2> cell_lines(const arrow::Table &a_cells,
+                                      const std::string &a_name,
+                                      int64_t a_row) {
+  const auto lines =
+      cell_list<arrow::StringArray>(a_cells, a_name, arrow::utf8(), a_row);
+  if (lines->length() != 2) {
+    throw std::invalid_argument("Malformed frame header in the cells table");
+  }
+  return {lines->GetString(0), lines->GetString(1)};
+}
+} // namespace
+
 std::shared_ptr<arrow::Table>
 ConvertToArrowTable(const yodecon::types::ConFrame &conFrame) {
   // Create builders for each field
@@ -48,21 +413,8 @@ ConvertToArrowTable(const yodecon::types::ConFrame &conFrame) {
   // Create a schema
   auto schema = std::make_shared<arrow::Schema>(schema_vector);
 
-  std::vector<std::string> keys = {
-      "prebox_header", "boxl",           "angles",         "postbox_header",
-      "natm_types",    "natms_per_type", "masses_per_type"};
-
-  std::vector<std::string> values = {
-      yodecon::helpers::string::to_csv_string(conFrame.prebox_header),
-      yodecon::helpers::string::to_csv_string(conFrame.boxl),
-      yodecon::helpers::string::to_csv_string(conFrame.angles),
-      yodecon::helpers::string::to_csv_string(conFrame.postbox_header),
-      std::to_string(conFrame.natm_types),
-      yodecon::helpers::string::to_csv_string(conFrame.natms_per_type),
-      yodecon::helpers::string::to_csv_string(conFrame.masses_per_type)};
-
   // Create metadata
-  auto metadata = std::make_shared<arrow::KeyValueMetadata>(keys, values);
+  auto metadata = frame_metadata(conFrame);
 
   // Add metadata to schema
   schema = schema->WithMetadata(metadata);
@@ -77,6 +429,75 @@ ConvertToArrowTable(const yodecon::types::ConFrame &conFrame) {
   return table;
 }
 
+std::shared_ptr<arrow::Table>
+ConvertToArrowTable(yodecon::types::ConFrameVec &&a_frame) {
+  return convert_vec(std::move(a_frame));
+}
+
+std::shared_ptr<arrow::Table>
+ConvertToArrowTable(yodecon::types::ConFrameVecFloat &&a_frame) {
+  return convert_vec(std::move(a_frame));
+}
+
+template <typename Real>
+TrajectoryTables ConvertTrajectoryToArrow(
+    std::vector<yodecon::types::BasicConFrameVec<Real>> &&a_frames,
+    yodecon::helpers::parallel::ThreadPool &a_pool) {
+  const size_t nframes = a_frames.size();
+  for (const auto &frame : a_frames) {
+    check_columns(frame);
+  }
+  TrajectoryTables tables;
+  tables.cells = cell_table(a_frames);
+
+  // A single dictionary for every chunk, the symbols of each frame are
+  // gathered in parallel and merged in frame order
+  std::vector<std::vector<std::string>> frame_symbols(nframes);
+  a_pool.parallel_for(nframes, [&](size_t a_idx) {
+    collect_symbols(a_frames[a_idx].symbol, frame_symbols[a_idx]);
+  });
+  std::vector<std::string> distinct;
+  for (const auto &symbols : frame_symbols) {
+    for (const auto &symbol : symbols) {
+      if (std::find(distinct.begin(), distinct.end(), symbol) ==
+          distinct.end()) {
+        distinct.push_back(symbol);
+      }
+    }
+  }
+  const auto dictionary = make_dictionary(distinct);
+
+  auto fields = atom_fields<Real>();
+  fields.insert(fields.begin(), arrow::field("frame", arrow::int64()));
+  std::vector<arrow::ArrayVector> chunks(fields.size(),
+                                         arrow::ArrayVector(nframes));
+  a_pool.parallel_for(nframes, [&](size_t a_idx) {
+    auto &frame = a_frames[a_idx];
+    chunks[0][a_idx] = wrap_vector(
+        std::vector<int64_t>(frame.x.size(), static_cast<int64_t>(a_idx)));
+    auto arrays = atom_arrays(frame, distinct, dictionary);
+    for (size_t col{0}; col < arrays.size(); col++) {
+      chunks[col + 1][a_idx] = std::move(arrays[col]);
+    }
+  });
+
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+  for (size_t col{0}; col < fields.size(); col++) {
+    columns.push_back(std::make_shared<arrow::ChunkedArray>(
+        std::move(chunks[col]), fields[col]->type()));
+  }
+  tables.atoms = arrow::Table::Make(arrow::schema(fields), columns);
+  return tables;
+}
+
+#define YODECON_INSTANTIATE_TRAJECTORY(Real)                                   \
+  template TrajectoryTables ConvertTrajectoryToArrow<Real>(                    \
+      std::vector<yodecon::types::BasicConFrameVec<Real>> &&,                  \
+      yodecon::helpers::parallel::ThreadPool &);
+YODECON_INSTANTIATE_TRAJECTORY(double)
+YODECON_INSTANTIATE_TRAJECTORY(float)
+#undef YODECON_INSTANTIATE_TRAJECTORY
+
 std::shared_ptr<arrow::RecordBatch>
 get_chunk_as_record_batch(std::shared_ptr<arrow::Table> table,
                           int chunk_index) {
@@ -90,6 +511,176 @@ get_chunk_as_record_batch(std::shared_ptr<arrow::Table> table,
   return arrow::RecordBatch::Make(table->schema(), chunks[0]->length(), chunks);
 }
 
+void write_ipc(const std::string &a_fname, const arrow::Table &a_table) {
+  auto sink = arrow::io::FileOutputStream::Open(a_fname);
+  CHECK_ARROW_STATUS(sink.status());
+  auto writer = arrow::ipc::MakeFileWriter(*sink, a_table.schema());
+  CHECK_ARROW_STATUS(writer.status());
+  CHECK_ARROW_STATUS((*writer)->WriteTable(a_table));
+  CHECK_ARROW_STATUS((*writer)->Close());
+  CHECK_ARROW_STATUS((*sink)->Close());
+}
+
+std::shared_ptr<arrow::Table> read_ipc(const std::string &a_fname) {
+  auto file =
+      arrow::io::MemoryMappedFile::Open(a_fname, arrow::io::FileMode::READ);
+  CHECK_ARROW_STATUS(file.status());
+  auto reader = arrow::ipc::RecordBatchFileReader::Open(*file);
+  CHECK_ARROW_STATUS(reader.status());
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  for (int idx{0}; idx < (*reader)->num_record_batches(); idx++) {
+    auto batch = (*reader)->ReadRecordBatch(idx);
+    CHECK_ARROW_STATUS(batch.status());
+    batches.push_back(*batch);
+  }
+  auto table = arrow::Table::FromRecordBatches((*reader)->schema(), batches);
+  CHECK_ARROW_STATUS(table.status());
+  return *table;
+}
+
+template <typename Real>
+BasicArrowFrameView<Real>::BasicArrowFrameView(
+    std::shared_ptr<arrow::RecordBatch> a_batch)
+    : m_batch{std::move(a_batch)} {
+  const auto &metadata = m_batch->schema()->metadata();
+  if (!metadata) {
+    throw std::invalid_argument("The batch carries no frame header");
+  }
+  m_prebox_header = split_lines(metadata_value(*metadata, "prebox_header"));
+  m_postbox_header = split_lines(metadata_value(*metadata, "postbox_header"));
+  m_boxl = parse_triple(metadata_value(*metadata, "boxl"));
+  m_angles = parse_triple(metadata_value(*metadata, "angles"));
+  const auto natm_types =
+      parse_csv<size_t>(metadata_value(*metadata, "natm_types"));
+  m_natms_per_type =
+      parse_csv<size_t>(metadata_value(*metadata, "natms_per_type"));
+  m_masses_per_type =
+      parse_csv<double>(metadata_value(*metadata, "masses_per_type"));
+  if (natm_types.size() != 1 || m_natms_per_type.size() != natm_types[0] ||
+      m_masses_per_type.size() != natm_types[0]) {
+    throw std::invalid_argument("Malformed frame header metadata");
+  }
+  m_natm_types = natm_types[0];
+
+  bind_columns();
+}
+
+template <typename Real>
+BasicArrowFrameView<Real>::BasicArrowFrameView(
+    std::shared_ptr<arrow::RecordBatch> a_atoms, const arrow::Table &a_cells,
+    int64_t a_row)
+    : m_batch{std::move(a_atoms)} {
+  if (a_row < 0 || a_row >= a_cells.num_rows()) {
+    throw std::out_of_range("Frame " + std::to_string(a_row) +
+                            " is past the last frame");
+  }
+  const auto [natoms, natoms_idx] =
+      cell_at<arrow::Int64Array>(a_cells, "natoms", *arrow::int64(), a_row);
+  if (natoms->Value(natoms_idx) != m_batch->num_rows()) {
+    throw std::invalid_argument(
+        "The cells row describes a frame with another number of atoms");
+  }
+  const auto frame = m_batch->GetColumnByName("frame");
+  if (frame && frame->type()->Equals(*arrow::int64()) && frame->length() > 0) {
+    const auto [index, index_idx] =
+        cell_at<arrow::Int64Array>(a_cells, "frame", *arrow::int64(), a_row);
+    if (std::static_pointer_cast<arrow::Int64Array>(frame)->Value(0) !=
+        index->Value(index_idx)) {
+      throw std::invalid_argument(
+          "The atoms chunk belongs to another frame than the cells row");
+    }
+  }
+  const std::array<std::string, 3> lengths{"a", "b", "c"};
+  const std::array<std::string, 3> angles{"alpha", "beta", "gamma"};
+  for (size_t dim{0}; dim < 3; dim++) {
+    m_boxl[dim] = cell_double(a_cells, lengths[dim], a_row);
+    m_angles[dim] = cell_double(a_cells, angles[dim], a_row);
+  }
+  const auto [natm_types, types_idx] = cell_at<arrow::Int64Array>(
+      a_cells, "natm_types", *arrow::int64(), a_row);
+  const auto counts = cell_list<arrow::UInt64Array>(
+      a_cells, "natms_per_type", arrow::uint64(), a_row);
+  const auto masses = cell_list<arrow::DoubleArray>(
+      a_cells, "masses_per_type", arrow::float64(), a_row);
+  if (natm_types->Value(types_idx) != counts->length() ||
+      natm_types->Value(types_idx) != masses->length()) {
+    throw std::invalid_argument("Malformed frame header in the cells table");
+  }
+  m_natm_types = static_cast<size_t>(natm_types->Value(types_idx));
+  m_natms_per_type.assign(counts->raw_values(),
+                          counts->raw_values() + counts->length());
+  m_masses_per_type.assign(masses->raw_values(),
+                           masses->raw_values() + masses->length());
+  m_prebox_header = cell_lines(a_cells, "prebox_header", a_row);
+  m_postbox_header = cell_lines(a_cells, "postbox_header", a_row);
+  bind_columns();
+}
+
+template <typename Real> void BasicArrowFrameView<Real>::bind_columns() {
+  const auto &batch = *m_batch;
+  // Same metadata and column names, only the types tell the overloads apart
+  const auto symbol = batch.GetColumnByName("symbol");
+  const auto atom_id = batch.GetColumnByName("atom_id");
+  if ((symbol && symbol->type()->Equals(*arrow::utf8())) ||
+      (atom_id && atom_id->type()->Equals(*arrow::uint64()))) {
+    throw std::invalid_argument(
+        "Tables from the ConFrame overload (utf8 symbol, uint64 atom_id) "
+        "can not be viewed, convert a ConFrameVec instead");
+  }
+  m_symbol = column_as<arrow::DictionaryArray>(
+      batch, "symbol", *arrow::dictionary(arrow::int32(), arrow::utf8()));
+  m_dictionary =
+      std::static_pointer_cast<arrow::StringArray>(m_symbol->dictionary());
+  const auto real_type = arrow::CTypeTraits<Real>::type_singleton();
+  const auto x = batch.GetColumnByName("x");
+  if (x && !x->type()->Equals(*real_type) &&
+      (x->type()->Equals(*arrow::float32()) ||
+       x->type()->Equals(*arrow::float64()))) {
+    throw std::invalid_argument(
+        "The coordinates are " + x->type()->ToString() + ", view them with " +
+        (x->type()->Equals(*arrow::float32()) ? "ArrowFrameViewFloat"
+                                              : "ArrowFrameView"));
+  }
+  m_x = column_as<RealArray>(batch, "x", *real_type);
+  m_y = column_as<RealArray>(batch, "y", *real_type);
+  m_z = column_as<RealArray>(batch, "z", *real_type);
+  m_is_fixed =
+      column_as<arrow::BooleanArray>(batch, "is_fixed", *arrow::boolean());
+  m_atom_id = column_as<arrow::Int32Array>(batch, "atom_id", *arrow::int32());
+}
+
+template <typename Real>
+std::string_view BasicArrowFrameView<Real>::symbol(size_t a_idx) const {
+  return m_dictionary->GetView(
+      m_symbol->GetValueIndex(static_cast<int64_t>(a_idx)));
+}
+
+template <typename Real>
+types::BasicConFrameVec<Real> BasicArrowFrameView<Real>::to_frame() const {
+  types::BasicConFrameVec<Real> frame;
+  frame.prebox_header = m_prebox_header;
+  frame.postbox_header = m_postbox_header;
+  frame.boxl = m_boxl;
+  frame.angles = m_angles;
+  frame.natm_types = m_natm_types;
+  frame.natms_per_type = m_natms_per_type;
+  frame.masses_per_type = m_masses_per_type;
+  const size_t nrows = natoms();
+  frame.x.assign(x().begin(), x().end());
+  frame.y.assign(y().begin(), y().end());
+  frame.z.assign(z().begin(), z().end());
+  frame.atom_id.assign(atom_id().begin(), atom_id().end());
+  frame.symbol.reserve(nrows);
+  frame.is_fixed.resize(nrows);
+  for (size_t idx{0}; idx < nrows; idx++) {
+    frame.symbol.emplace_back(symbol(idx));
+    frame.is_fixed[idx] = is_fixed(idx);
+  }
+  return frame;
+}
+
+template class BasicArrowFrameView<double>;
+template class BasicArrowFrameView<float>;
 } // namespace yodecon::conarrow
 
-#endif // WITH_ARROW
+#endif // WITH_APACHE_ARROW
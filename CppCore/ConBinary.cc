@@ -0,0 +1,409 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+#include "readCon/include/ConBinary.hpp"
+#include "readCon/include/ConFrameStream.hpp"
+#include "readCon/include/helpers/ByteHelpers.hpp"
+
+namespace yodecon::conb {
+using helpers::bytes::get_f64;
+using helpers::bytes::get_u32;
+using helpers::bytes::get_u64;
+using helpers::bytes::host_is_little_endian;
+using helpers::bytes::put_f64;
+using helpers::bytes::put_u32;
+using helpers::bytes::put_u64;
+
+namespace {
+size_t padded(size_t a_nbytes) {
+  return (a_nbytes + Alignment - 1) / Alignment * Alignment;
+}
+
+void pad(std::string &a_out) {
+  a_out.append(padded(a_out.size()) - a_out.size(), '\0');
+}
+
+void put_string(std::string &a_out, std::string_view a_str) {
+  put_u64(a_out, a_str.size());
+  a_out.append(a_str);
+  pad(a_out);
+}
+
+// Appends a column of doubles, in one copy when the host byte order matches
+void put_f64_column(std::string &a_out, const std::vector<double> &a_col) {
+  if (host_is_little_endian()) {
+    a_out.append(reinterpret_cast<const char *>(a_col.data()),
+                 a_col.size() * sizeof(double));
+    return;
+  }
+  for (double val : a_col) {
+    put_f64(a_out, val);
+  }
+}
+
+void get_f64_column(const char *a_ptr, size_t a_count,
+                    std::vector<double> &a_col) {
+  a_col.resize(a_count);
+  if (host_is_little_endian()) {
+    std::memcpy(a_col.data(), a_ptr, a_count * sizeof(double));
+    return;
+  }
+  for (size_t idx{0}; idx < a_count; idx++) {
+    a_col[idx] = get_f64(a_ptr + idx * sizeof(double));
+  }
+}
+
+// Walks a frame record field by field, checking every field is in bounds
+class RecordCursor {
+public:
+  explicit RecordCursor(std::string_view a_record) : m_record{a_record} {}
+
+  const char *take(size_t a_nbytes) {
+    const size_t len = padded(a_nbytes);
+    if (len < a_nbytes || len > m_record.size() - m_pos) {
+      throw std::invalid_argument("Truncated .conb frame");
+    }
+    const char *field = m_record.data() + m_pos;
+    m_pos += len;
+    return field;
+  }
+  //! Like take(), for `a_count` elements of `a_size` bytes each
+  const char *take(size_t a_count, size_t a_size) {
+    if (a_size != 0 && a_count > m_record.size() / a_size) {
+      throw std::invalid_argument("Truncated .conb frame");
+    }
+    return take(a_count * a_size);
+  }
+  uint64_t u64() { return get_u64(take(sizeof(uint64_t))); }
+  double f64() { return get_f64(take(sizeof(double))); }
+  std::string_view string() {
+    const uint64_t len = u64();
+    return {take(len, 1), len};
+  }
+
+private:
+  std::string_view m_record;
+  size_t m_pos{0};
+};
+} // namespace
+
+void encode_frame(const types::ConFrameVec &a_frame, std::string &a_out) {
+  const size_t natoms = a_frame.x.size();
+  if (a_frame.y.size() != natoms || a_frame.z.size() != natoms ||
+      a_frame.atom_id.size() != natoms ||
+      a_frame.is_fixed.size() != natoms || a_frame.symbol.size() != natoms) {
+    throw std::invalid_argument("Columns of the frame differ in length");
+  }
+  if (a_frame.natms_per_type.size() != a_frame.natm_types ||
+      a_frame.masses_per_type.size() != a_frame.natm_types) {
+    throw std::invalid_argument(
+        "natms_per_type and masses_per_type need an entry per component");
+  }
+  std::vector<std::string_view> type_symbols;
+  type_symbols.reserve(a_frame.natm_types);
+  size_t first{0};
+  for (size_t natms : a_frame.natms_per_type) {
+    if (natms > natoms - first) {
+      throw std::invalid_argument("natms_per_type exceeds the atoms");
+    }
+    const std::string_view symbol =
+        natms == 0 ? std::string_view{} : a_frame.symbol[first];
+    for (size_t idx{first}; idx < first + natms; idx++) {
+      if (a_frame.symbol[idx] != symbol) {
+        throw std::invalid_argument(
+            "Atoms of a component must share one symbol");
+      }
+    }
+    type_symbols.push_back(symbol);
+    first += natms;
+  }
+  if (first != natoms) {
+    throw std::invalid_argument("natms_per_type does not add up to the atoms");
+  }
+
+  put_u64(a_out, natoms);
+  put_u64(a_out, a_frame.natm_types);
+  for (double val : a_frame.boxl) {
+    put_f64(a_out, val);
+  }
+  for (double val : a_frame.angles) {
+    put_f64(a_out, val);
+  }
+  for (const auto &line : a_frame.prebox_header) {
+    put_string(a_out, line);
+  }
+  for (const auto &line : a_frame.postbox_header) {
+    put_string(a_out, line);
+  }
+  for (size_t natms : a_frame.natms_per_type) {
+    put_u64(a_out, natms);
+  }
+  put_f64_column(a_out, a_frame.masses_per_type);
+  for (auto symbol : type_symbols) {
+    put_string(a_out, symbol);
+  }
+  put_f64_column(a_out, a_frame.x);
+  put_f64_column(a_out, a_frame.y);
+  put_f64_column(a_out, a_frame.z);
+  for (int atom_id : a_frame.atom_id) {
+    put_u32(a_out, static_cast<uint32_t>(atom_id));
+  }
+  pad(a_out);
+  for (bool fixed : a_frame.is_fixed) {
+    a_out.push_back(static_cast<char>(fixed ? 1 : 0));
+  }
+  pad(a_out);
+}
+
+FrameView::FrameView(std::string_view a_record) {
+  RecordCursor cursor{a_record};
+  m_natoms = cursor.u64();
+  m_natm_types = cursor.u64();
+  for (auto &val : m_boxl) {
+    val = cursor.f64();
+  }
+  for (auto &val : m_angles) {
+    val = cursor.f64();
+  }
+  for (auto &line : m_prebox_header) {
+    line = cursor.string();
+  }
+  for (auto &line : m_postbox_header) {
+    line = cursor.string();
+  }
+  m_natms_per_type = cursor.take(m_natm_types, sizeof(uint64_t));
+  m_masses_per_type = cursor.take(m_natm_types, sizeof(double));
+  m_type_symbols.reserve(m_natm_types);
+  uint64_t total{0};
+  for (size_t idx{0}; idx < m_natm_types; idx++) {
+    const uint64_t count = get_u64(m_natms_per_type + idx * sizeof(uint64_t));
+    // Bounding each count keeps the sum from wrapping around to m_natoms
+    if (count > m_natoms - total) {
+      throw std::invalid_argument("natms_per_type exceeds the atoms");
+    }
+    total += count;
+    m_type_symbols.push_back(cursor.string());
+  }
+  if (total != m_natoms) {
+    throw std::invalid_argument("natms_per_type does not add up to the atoms");
+  }
+  m_x = cursor.take(m_natoms, sizeof(double));
+  m_y = cursor.take(m_natoms, sizeof(double));
+  m_z = cursor.take(m_natoms, sizeof(double));
+  m_atom_id = cursor.take(m_natoms, sizeof(int32_t));
+  m_is_fixed = cursor.take(m_natoms, sizeof(uint8_t));
+}
+
+ColumnView<uint64_t> FrameView::natms_per_type() const noexcept {
+  return {reinterpret_cast<const uint64_t *>(m_natms_per_type), m_natm_types};
+}
+ColumnView<double> FrameView::masses_per_type() const noexcept {
+  return {reinterpret_cast<const double *>(m_masses_per_type), m_natm_types};
+}
+ColumnView<double> FrameView::x() const noexcept {
+  return {reinterpret_cast<const double *>(m_x), m_natoms};
+}
+ColumnView<double> FrameView::y() const noexcept {
+  return {reinterpret_cast<const double *>(m_y), m_natoms};
+}
+ColumnView<double> FrameView::z() const noexcept {
+  return {reinterpret_cast<const double *>(m_z), m_natoms};
+}
+ColumnView<int32_t> FrameView::atom_id() const noexcept {
+  return {reinterpret_cast<const int32_t *>(m_atom_id), m_natoms};
+}
+ColumnView<uint8_t> FrameView::is_fixed() const noexcept {
+  return {reinterpret_cast<const uint8_t *>(m_is_fixed), m_natoms};
+}
+
+types::ConFrameVec FrameView::to_frame() const {
+  types::ConFrameVec frame;
+  for (size_t idx{0}; idx < 2; idx++) {
+    frame.prebox_header[idx] = std::string{m_prebox_header[idx]};
+    frame.postbox_header[idx] = std::string{m_postbox_header[idx]};
+  }
+  frame.boxl = m_boxl;
+  frame.angles = m_angles;
+  frame.natm_types = m_natm_types;
+  frame.natms_per_type.resize(m_natm_types);
+  for (size_t idx{0}; idx < m_natm_types; idx++) {
+    frame.natms_per_type[idx] =
+        get_u64(m_natms_per_type + idx * sizeof(uint64_t));
+  }
+  get_f64_column(m_masses_per_type, m_natm_types, frame.masses_per_type);
+  frame.symbol.reserve(m_natoms);
+  for (size_t idx{0}; idx < m_natm_types; idx++) {
+    frame.symbol.insert(frame.symbol.end(), frame.natms_per_type[idx],
+                        std::string{m_type_symbols[idx]});
+  }
+  get_f64_column(m_x, m_natoms, frame.x);
+  get_f64_column(m_y, m_natoms, frame.y);
+  get_f64_column(m_z, m_natoms, frame.z);
+  frame.atom_id.resize(m_natoms);
+  frame.is_fixed.resize(m_natoms);
+  for (size_t idx{0}; idx < m_natoms; idx++) {
+    frame.atom_id[idx] =
+        static_cast<int32_t>(get_u32(m_atom_id + idx * sizeof(int32_t)));
+    frame.is_fixed[idx] = m_is_fixed[idx] != 0;
+  }
+  return frame;
+}
+
+ConbWriter::ConbWriter(const std::string &a_fname) : m_fname{a_fname} {
+  m_out.open(a_fname, std::ios::binary | std::ios::trunc);
+  if (!m_out.is_open()) {
+    throw std::runtime_error("Failed to open the file");
+  }
+  // Filled in by finish()
+  m_out.write(std::string(HeaderSize, '\0').data(), HeaderSize);
+}
+
+ConbWriter::~ConbWriter() {
+  // Finishing while unwinding would pass a truncated trajectory off as whole
+  if (m_failed || std::uncaught_exceptions() > m_uncaught) {
+    discard();
+    return;
+  }
+  try {
+    finish();
+  } catch (...) {
+    // Destructors must not throw, call finish() to see errors
+  }
+}
+
+void ConbWriter::discard() noexcept {
+  if (m_finished) {
+    return;
+  }
+  m_finished = true;
+  m_out.close();
+  std::error_code ec;
+  std::filesystem::remove(m_fname, ec);
+}
+
+void ConbWriter::write(const types::ConFrameVec &a_frame) {
+  m_buffer.clear();
+  encode_frame(a_frame, m_buffer);
+  if (!m_out.write(m_buffer.data(),
+                   static_cast<std::streamsize>(m_buffer.size()))) {
+    m_failed = true;
+    throw std::runtime_error("Failed to write " + m_fname);
+  }
+  m_offsets.push_back(m_pos);
+  m_nbytes.push_back(m_buffer.size());
+  m_pos += m_buffer.size();
+}
+
+void ConbWriter::finish() {
+  if (m_finished) {
+    return;
+  }
+  m_finished = true;
+  m_buffer.clear();
+  for (size_t idx{0}; idx < m_offsets.size(); idx++) {
+    put_u64(m_buffer, m_offsets[idx]);
+    put_u64(m_buffer, m_nbytes[idx]);
+  }
+  m_out.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+  m_buffer.clear();
+  m_buffer.append(Magic, sizeof(Magic));
+  put_u32(m_buffer, FormatVersion);
+  put_u32(m_buffer, 0);
+  put_u64(m_buffer, m_offsets.size());
+  put_u64(m_buffer, m_pos);
+  m_out.seekp(0);
+  m_out.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+  m_out.close();
+  if (!m_out) {
+    throw std::runtime_error("Failed to write " + m_fname);
+  }
+}
+
+void write_conb(const std::string &a_fname,
+                const std::vector<types::ConFrameVec> &a_frames) {
+  ConbWriter out{a_fname};
+  for (const auto &frame : a_frames) {
+    out.write(frame);
+  }
+  out.finish();
+}
+
+size_t convert_to_conb(const std::string &a_con, const std::string &a_conb) {
+  ConFrameStream<types::ConFrameVec> frames{a_con};
+  ConbWriter out{a_conb};
+  types::ConFrameVec frame;
+  try {
+    while (frames.next(frame)) {
+      out.write(frame);
+    }
+  } catch (...) {
+    // No partial .conb, even if the error is caught further up
+    out.discard();
+    throw;
+  }
+  out.finish();
+  return out.size();
+}
+
+ConbReader::ConbReader(const std::string &a_fname) : m_mapped{a_fname} {
+  const char *data = m_mapped.data();
+  const size_t size = m_mapped.size();
+  if (size < HeaderSize || std::memcmp(data, Magic, sizeof(Magic)) != 0) {
+    throw std::invalid_argument(a_fname + " is not a .conb file");
+  }
+  if (get_u32(data + 8) != FormatVersion) {
+    throw std::invalid_argument("Unsupported .conb version " +
+                                std::to_string(get_u32(data + 8)));
+  }
+  const uint64_t nframes = get_u64(data + 16);
+  const uint64_t table_offset = get_u64(data + 24);
+  if (table_offset < HeaderSize || table_offset > size ||
+      nframes > (size - table_offset) / TableEntrySize) {
+    throw std::invalid_argument("Corrupt .conb frame table");
+  }
+  m_records.reserve(nframes);
+  const char *entry = data + table_offset;
+  for (uint64_t idx{0}; idx < nframes; idx++) {
+    const uint64_t offset = get_u64(entry);
+    const uint64_t nbytes = get_u64(entry + 8);
+    if (offset % Alignment != 0 || offset < HeaderSize ||
+        offset > table_offset || nbytes > table_offset - offset) {
+      throw std::invalid_argument("Corrupt .conb frame table");
+    }
+    m_records.emplace_back(data + offset, nbytes);
+    entry += TableEntrySize;
+  }
+}
+
+const std::string_view &ConbReader::record(size_t a_idx) const {
+  if (a_idx >= m_records.size()) {
+    throw std::out_of_range("Frame " + std::to_string(a_idx) +
+                            " is past the last frame");
+  }
+  return m_records[a_idx];
+}
+
+FrameView ConbReader::frame(size_t a_idx) const {
+  if (!host_is_little_endian()) {
+    throw std::runtime_error(
+        "Frames of a .conb file can only be viewed on little-endian hosts");
+  }
+  return FrameView{record(a_idx)};
+}
+
+types::ConFrameVec ConbReader::read_frame(size_t a_idx) const {
+  return FrameView{record(a_idx)}.to_frame();
+}
+
+std::vector<types::ConFrameVec> ConbReader::read_all() const {
+  std::vector<types::ConFrameVec> frames;
+  frames.reserve(m_records.size());
+  for (const auto &rec : m_records) {
+    frames.push_back(FrameView{rec}.to_frame());
+  }
+  return frames;
+}
+} // namespace yodecon::conb
@@ -0,0 +1,107 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+#include "readCon/include/Compression.hpp"
+#include "readCon/include/ConFrameStream.hpp"
+
+namespace fs = std::filesystem;
+
+namespace yodecon {
+FrameReader::FrameReader(const std::string &a_fname, size_t a_chunk_size)
+    : m_chunk_size{std::max<size_t>(a_chunk_size, 1)} {
+  m_owned = compression::open_input(a_fname);
+  m_stream = m_owned.get();
+}
+
+FrameReader::FrameReader(std::istream &a_stream, size_t a_chunk_size)
+    : m_stream{&a_stream}, m_chunk_size{std::max<size_t>(a_chunk_size, 1)} {}
+
+bool FrameReader::next(std::string_view &a_frame) {
+  return extract(a_frame, true);
+}
+
+void FrameReader::seek(size_t a_offset) {
+  m_stream->seekg(static_cast<std::streamoff>(a_offset));
+  if (!*m_stream) {
+    throw std::runtime_error("Failed to seek to byte offset " +
+                             std::to_string(a_offset));
+  }
+  m_begin = m_end = 0;
+  m_consumed = a_offset;
+}
+
+bool FrameReader::fill() {
+  // Drop what has already been handed out
+  if (m_begin > 0) {
+    std::memmove(m_buffer.data(), m_buffer.data() + m_begin, m_end - m_begin);
+    m_end -= m_begin;
+    m_begin = 0;
+  }
+  // Read at least as much as is pending, so that a frame spanning many chunks
+  // is only rescanned a logarithmic number of times
+  const size_t want = std::max(m_chunk_size, m_end);
+  if (m_buffer.size() < m_end + want) {
+    m_buffer.resize(m_end + want);
+  }
+  m_stream->read(m_buffer.data() + m_end, static_cast<std::streamsize>(want));
+  const auto got = static_cast<size_t>(m_stream->gcount());
+  m_end += got;
+  return got > 0;
+}
+
+bool FrameReader::extract(std::string_view &a_frame, bool a_final) {
+  while (true) {
+    const bool drained = m_stream->eof();
+    std::string_view avail{m_buffer.data() + m_begin, m_end - m_begin};
+    std::string_view complete{avail};
+    if (!(a_final && drained)) {
+      // The last line may still be incomplete, only look at whole lines
+      const size_t last_newline = avail.rfind('\n');
+      complete = last_newline == std::string_view::npos
+                     ? std::string_view{}
+                     : avail.substr(0, last_newline + 1);
+    }
+    helpers::string::LineCursor cursor{complete};
+    types::FrameOffset entry{};
+    if (!cursor.at_end() && scan_frame(cursor, entry)) {
+      a_frame = complete.substr(0, entry.nbytes);
+      m_begin += entry.nbytes;
+      m_consumed += entry.nbytes;
+      return true;
+    }
+    if (drained) {
+      if (a_final && !helpers::string::LineCursor{avail}.at_end()) {
+        throw std::invalid_argument("Truncated frame at byte offset " +
+                                    std::to_string(m_consumed));
+      }
+      return false;
+    }
+    fill();
+  }
+}
+
+FollowReader::FollowReader(const std::string &a_fname, size_t a_offset,
+                           size_t a_chunk_size)
+    : FrameReader{a_fname, a_chunk_size}, m_fname{a_fname} {
+  if (compression::detect_codec_of(a_fname) != compression::Codec::None) {
+    throw std::runtime_error("Compressed files can not be followed");
+  }
+  if (fs::file_size(a_fname) < a_offset) {
+    throw std::runtime_error("Offset is past the end of the file");
+  }
+  seek(a_offset);
+}
+
+bool FollowReader::next(std::string_view &a_frame) {
+  if (fs::file_size(m_fname) < consumed() + pending()) {
+    throw std::runtime_error("File was truncated while being followed");
+  }
+  // Clear the end of file from the last poll so new bytes are read
+  stream().clear();
+  return extract(a_frame, false);
+}
+} // namespace yodecon
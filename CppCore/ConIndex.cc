@@ -0,0 +1,114 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include "readCon/include/ConIndex.hpp"
+#include "readCon/include/Compression.hpp"
+
+namespace yodecon {
+namespace {
+// Offsets index the text itself, so compressed bytes cannot be indexed in
+// place, only decompressed first
+void reject_compressed(std::string_view a_fconts) {
+  const auto codec = compression::detect_codec(
+      a_fconts.substr(0, compression::MagicLength));
+  if (codec != compression::Codec::None) {
+    throw std::invalid_argument(
+        "Compressed input (" + std::string{compression::codec_name(codec)} +
+        "), use compression::open_input or ConFrameStream");
+  }
+}
+} // namespace
+
+bool scan_frame(yodecon::helpers::string::LineCursor &a_cursor,
+                types::FrameOffset &a_entry) {
+  a_entry.offset = a_cursor.offset();
+  std::string_view line;
+  if (a_cursor.skip(2) != 2 || !a_cursor.next(line)) {
+    return false;
+  }
+  a_entry.boxl = {};
+  helpers::string::scan_numbers(line, a_entry.boxl);
+  if (!a_cursor.next(line)) {
+    return false;
+  }
+  a_entry.angles = {};
+  helpers::string::scan_numbers(line, a_entry.angles);
+  // Only the 7th and 8th header lines determine the frame length
+  if (a_cursor.skip(2) != 2 || !a_cursor.next(line)) {
+    return false;
+  }
+  const size_t natm_types =
+      helpers::string::get_array_from_string<size_t, 1>(line)[0];
+  a_entry.natm_types = natm_types;
+  if (!a_cursor.next(line)) {
+    return false;
+  }
+  const auto natms_per_type =
+      helpers::string::get_val_from_string<size_t>(line, natm_types);
+  if (natms_per_type.size() != natm_types) {
+    throw std::invalid_argument(
+        "natms_per_type must have an entry for each of the natm_types");
+  }
+  a_entry.natoms = std::accumulate(natms_per_type.begin(),
+                                   natms_per_type.end(), size_t{0});
+  const size_t nbodylines =
+      1 + (natm_types * constants::CoordHeader) + a_entry.natoms;
+  if (a_cursor.skip(nbodylines) != nbodylines) {
+    return false;
+  }
+  a_entry.nbytes = a_cursor.offset() - a_entry.offset;
+  return true;
+}
+
+ConIndex::ConIndex(std::string_view a_fconts) { extend(a_fconts); }
+
+ConIndex::ConIndex(std::string_view a_fconts,
+                   std::vector<types::FrameOffset> a_frames)
+    : m_fconts{a_fconts}, m_frames{std::move(a_frames)} {
+  reject_compressed(m_fconts);
+  if (indexed_bytes() > m_fconts.size()) {
+    throw std::invalid_argument("Frame offsets extend past the buffer");
+  }
+}
+
+size_t ConIndex::extend(std::string_view a_fconts) {
+  if (a_fconts.size() < indexed_bytes()) {
+    throw std::invalid_argument("Buffer is shorter than the indexed frames");
+  }
+  if (indexed_bytes() == 0) {
+    reject_compressed(a_fconts);
+  }
+  m_fconts = a_fconts;
+  helpers::string::LineCursor cursor{m_fconts.substr(indexed_bytes())};
+  const size_t base{indexed_bytes()};
+  const size_t nold{m_frames.size()};
+  types::FrameOffset entry{};
+  while (!cursor.at_end()) {
+    if (!scan_frame(cursor, entry)) {
+      throw std::invalid_argument("Truncated frame at byte offset " +
+                                  std::to_string(base + entry.offset));
+    }
+    entry.offset += base;
+    m_frames.push_back(entry);
+  }
+  return m_frames.size() - nold;
+}
+
+bool next_selected(yodecon::helpers::string::LineCursor &a_cursor,
+                   const FrameSlice &a_slice, size_t &a_idx) {
+  if (a_slice.step == 0) {
+    throw std::invalid_argument("Slice step must be positive");
+  }
+  types::FrameOffset entry{};
+  while (a_idx < a_slice.stop && !a_cursor.at_end()) {
+    if (a_slice.selects(a_idx)) {
+      return true;
+    }
+    if (!scan_frame(a_cursor, entry)) {
+      throw std::invalid_argument("Truncated frame at byte offset " +
+                                  std::to_string(entry.offset));
+    }
+    ++a_idx;
+  }
+  return false;
+}
+} // namespace yodecon
@@ -0,0 +1,145 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+
+#include "readCon/include/ConIndexFile.hpp"
+#include "readCon/include/helpers/ByteHelpers.hpp"
+
+namespace fs = std::filesystem;
+
+namespace yodecon::idxfile {
+using helpers::bytes::get_f64;
+using helpers::bytes::get_u32;
+using helpers::bytes::get_u64;
+using helpers::bytes::put_f64;
+using helpers::bytes::put_u32;
+using helpers::bytes::put_u64;
+using helpers::file::file_mtime;
+
+uint64_t tail_hash(std::string_view a_fconts, size_t a_end) {
+  constexpr uint64_t fnv_offset{14695981039346656037ULL};
+  constexpr uint64_t fnv_prime{1099511628211ULL};
+  const size_t begin = a_end > TailBytes ? a_end - TailBytes : 0;
+  uint64_t hash{fnv_offset};
+  for (size_t idx{begin}; idx < a_end && idx < a_fconts.size(); idx++) {
+    hash ^= static_cast<unsigned char>(a_fconts[idx]);
+    hash *= fnv_prime;
+  }
+  return hash;
+}
+
+bool write_sidecar(const std::string &a_fname, const ConIndex &a_index) {
+  auto mtime = file_mtime(a_fname);
+  if (!mtime.has_value()) {
+    return false;
+  }
+  std::string out;
+  out.reserve(HeaderSize + a_index.size() * RecordSize);
+  out.append(Magic, sizeof(Magic));
+  put_u32(out, FormatVersion);
+  put_u32(out, RecordSize);
+  // The size of the indexed buffer, not of the file now, so that bytes written
+  // after the buffer was mapped are picked up as an append next time
+  put_u64(out, a_index.fconts().size());
+  put_u64(out, static_cast<uint64_t>(mtime.value()));
+  put_u64(out, a_index.indexed_bytes());
+  put_u64(out, tail_hash(a_index.fconts(), a_index.indexed_bytes()));
+  put_u64(out, a_index.size());
+  for (const auto &entry : a_index.frames()) {
+    put_u64(out, entry.offset);
+    put_u64(out, entry.nbytes);
+    put_u64(out, entry.natoms);
+    put_u64(out, entry.natm_types);
+    for (double val : entry.boxl) {
+      put_f64(out, val);
+    }
+    for (double val : entry.angles) {
+      put_f64(out, val);
+    }
+  }
+
+  return helpers::file::write_atomically(sidecar_path(a_fname), out);
+}
+
+std::optional<std::vector<types::FrameOffset>>
+read_sidecar(const std::string &a_fname, SidecarInfo &a_info) {
+  const std::string path = sidecar_path(a_fname);
+  std::error_code ec;
+  if (!fs::exists(path, ec)) {
+    return std::nullopt;
+  }
+  // A sidecar that cannot be opened or mapped is as good as a missing one
+  std::optional<helpers::file::MappedFile> sidecar;
+  try {
+    sidecar.emplace(path);
+  } catch (const std::runtime_error &) {
+    return std::nullopt;
+  }
+  const auto &mapped = *sidecar;
+  const char *data = mapped.data();
+  if (mapped.size() < HeaderSize ||
+      std::memcmp(data, Magic, sizeof(Magic)) != 0 ||
+      get_u32(data + 8) != FormatVersion || get_u32(data + 12) != RecordSize) {
+    return std::nullopt;
+  }
+  a_info.file_size = get_u64(data + 16);
+  a_info.mtime = static_cast<int64_t>(get_u64(data + 24));
+  a_info.indexed_bytes = get_u64(data + 32);
+  a_info.tail_hash = get_u64(data + 40);
+  const uint64_t nframes = get_u64(data + 48);
+  if ((mapped.size() - HeaderSize) / RecordSize != nframes ||
+      (mapped.size() - HeaderSize) % RecordSize != 0) {
+    return std::nullopt;
+  }
+
+  std::vector<types::FrameOffset> frames(nframes);
+  const char *rec = data + HeaderSize;
+  for (auto &entry : frames) {
+    entry.offset = get_u64(rec);
+    entry.nbytes = get_u64(rec + 8);
+    entry.natoms = get_u64(rec + 16);
+    entry.natm_types = get_u64(rec + 24);
+    for (size_t dim{0}; dim < 3; dim++) {
+      entry.boxl[dim] = get_f64(rec + 32 + 8 * dim);
+      entry.angles[dim] = get_f64(rec + 56 + 8 * dim);
+    }
+    rec += RecordSize;
+  }
+  return frames;
+}
+
+ConIndex load_or_build(const std::string &a_fname, std::string_view a_fconts,
+                       bool a_write) {
+  SidecarInfo info{};
+  auto frames = read_sidecar(a_fname, info);
+  const auto mtime = file_mtime(a_fname);
+  if (frames.has_value() && info.indexed_bytes <= info.file_size &&
+      info.indexed_bytes <= a_fconts.size() &&
+      (frames->empty() ? 0
+                       : frames->back().offset + frames->back().nbytes) ==
+          info.indexed_bytes) {
+    if (info.file_size == a_fconts.size() && mtime == info.mtime) {
+      return ConIndex{a_fconts, std::move(frames.value())};
+    }
+    // Appended to, provided the indexed prefix is untouched
+    if (a_fconts.size() > info.file_size &&
+        tail_hash(a_fconts, info.indexed_bytes) == info.tail_hash) {
+      ConIndex index{a_fconts, std::move(frames.value())};
+      index.extend(a_fconts);
+      if (a_write) {
+        write_sidecar(a_fname, index);
+      }
+      return index;
+    }
+  }
+  ConIndex index{a_fconts};
+  if (a_write) {
+    write_sidecar(a_fname, index);
+  }
+  return index;
+}
+} // namespace yodecon::idxfile
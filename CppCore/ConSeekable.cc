@@ -0,0 +1,259 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+
+#include "readCon/include/ConSeekable.hpp"
+#include "readCon/include/helpers/ByteHelpers.hpp"
+
+namespace fs = std::filesystem;
+
+namespace yodecon::seekable {
+using helpers::bytes::get_u32;
+using helpers::bytes::get_u64;
+using helpers::bytes::put_u32;
+using helpers::bytes::put_u64;
+
+namespace {
+constexpr size_t NoBlock{std::numeric_limits<size_t>::max()};
+
+// The stored index, provided it describes the file as it is now
+std::optional<std::vector<BlockEntry>>
+read_sidecar(const std::string &a_fname, compression::Codec a_codec,
+             size_t a_file_size) {
+  const std::string path = sidecar_path(a_fname);
+  std::error_code ec;
+  if (!fs::exists(path, ec)) {
+    return std::nullopt;
+  }
+  helpers::file::MappedFile mapped{path};
+  const char *data = mapped.data();
+  if (mapped.size() < HeaderSize ||
+      std::memcmp(data, Magic, sizeof(Magic)) != 0 ||
+      get_u32(data + 8) != FormatVersion ||
+      get_u32(data + 12) != static_cast<uint32_t>(a_codec) ||
+      get_u64(data + 16) != a_file_size ||
+      static_cast<int64_t>(get_u64(data + 24)) !=
+          helpers::file::file_mtime(a_fname)) {
+    return std::nullopt;
+  }
+  const uint64_t nblocks = get_u64(data + 32);
+  if ((mapped.size() - HeaderSize) % RecordSize != 0 ||
+      (mapped.size() - HeaderSize) / RecordSize != nblocks) {
+    return std::nullopt;
+  }
+  std::vector<BlockEntry> blocks(nblocks);
+  const char *rec = data + HeaderSize;
+  for (auto &block : blocks) {
+    block.offset = get_u64(rec);
+    block.nbytes = get_u64(rec + 8);
+    block.first_frame = get_u64(rec + 16);
+    block.nframes = get_u64(rec + 24);
+    block.raw_bytes = get_u64(rec + 32);
+    if (block.offset + block.nbytes > a_file_size) {
+      return std::nullopt;
+    }
+    rec += RecordSize;
+  }
+  return blocks;
+}
+} // namespace
+
+SeekableWriter::SeekableWriter(const std::string &a_fname,
+                               compression::Codec a_codec,
+                               size_t a_frames_per_block)
+    : m_fname{a_fname}, m_codec{a_codec},
+      m_frames_per_block{std::max<size_t>(a_frames_per_block, 1)} {
+  if (a_codec == compression::Codec::None ||
+      !compression::is_supported(a_codec)) {
+    throw std::runtime_error(
+        std::string{"Can not write seekable trajectories with "} +
+        std::string{compression::codec_name(a_codec)} + " blocks");
+  }
+  m_out.open(a_fname, std::ios::binary | std::ios::trunc);
+  if (!m_out.is_open()) {
+    throw std::runtime_error("Failed to open the file");
+  }
+}
+
+SeekableWriter::~SeekableWriter() {
+  // Finishing while unwinding would pass a truncated trajectory off as whole
+  if (m_failed || std::uncaught_exceptions() > m_uncaught) {
+    discard();
+    return;
+  }
+  try {
+    finish();
+  } catch (...) {
+    // Destructors must not throw, call finish() to see errors
+  }
+}
+
+void SeekableWriter::discard() noexcept {
+  if (m_finished) {
+    return;
+  }
+  m_finished = true;
+  m_out.close();
+  std::error_code ec;
+  fs::remove(m_fname, ec);
+  fs::remove(sidecar_path(m_fname), ec);
+}
+
+void SeekableWriter::write_frames(std::string_view a_fconts) {
+  const ConIndex index{a_fconts};
+  for (const auto &entry : index.frames()) {
+    m_pending.append(a_fconts.substr(entry.offset, entry.nbytes));
+    if (++m_pending_frames == m_frames_per_block) {
+      flush_block();
+    }
+  }
+}
+
+void SeekableWriter::flush_block() {
+  if (m_pending_frames == 0) {
+    return;
+  }
+  const std::string packed = compression::compress(m_pending, m_codec);
+  BlockEntry block{};
+  block.offset = m_blocks.empty()
+                     ? 0
+                     : m_blocks.back().offset + m_blocks.back().nbytes;
+  block.nbytes = packed.size();
+  block.first_frame = m_nframes;
+  block.nframes = m_pending_frames;
+  block.raw_bytes = m_pending.size();
+  if (!m_out.write(packed.data(), static_cast<std::streamsize>(packed.size())))
+  {
+    m_failed = true;
+    throw std::runtime_error("Failed to write " + m_fname);
+  }
+  m_blocks.push_back(block);
+  m_nframes += m_pending_frames;
+  m_pending.clear();
+  m_pending_frames = 0;
+}
+
+void SeekableWriter::finish() {
+  if (m_finished) {
+    return;
+  }
+  m_finished = true;
+  flush_block();
+  m_out.close();
+  if (!m_out) {
+    throw std::runtime_error("Failed to write " + m_fname);
+  }
+  // Written after closing, so the recorded size and mtime are final
+  if (!write_sidecar(m_fname, m_codec, m_blocks)) {
+    throw std::runtime_error("Failed to write " + sidecar_path(m_fname));
+  }
+}
+
+bool write_sidecar(const std::string &a_fname, compression::Codec a_codec,
+                   const std::vector<BlockEntry> &a_blocks) {
+  std::error_code ec;
+  const auto file_size = fs::file_size(a_fname, ec);
+  const auto mtime = helpers::file::file_mtime(a_fname);
+  if (ec || !mtime.has_value()) {
+    return false;
+  }
+  std::string out;
+  out.reserve(HeaderSize + a_blocks.size() * RecordSize);
+  out.append(Magic, sizeof(Magic));
+  put_u32(out, FormatVersion);
+  put_u32(out, static_cast<uint32_t>(a_codec));
+  put_u64(out, file_size);
+  put_u64(out, static_cast<uint64_t>(mtime.value()));
+  put_u64(out, a_blocks.size());
+  for (const auto &block : a_blocks) {
+    put_u64(out, block.offset);
+    put_u64(out, block.nbytes);
+    put_u64(out, block.first_frame);
+    put_u64(out, block.nframes);
+    put_u64(out, block.raw_bytes);
+  }
+  return helpers::file::write_atomically(sidecar_path(a_fname), out);
+}
+
+std::vector<BlockEntry> build_blocks(std::string_view a_compressed,
+                                     compression::Codec a_codec) {
+  std::vector<BlockEntry> blocks;
+  std::string raw;
+  size_t offset{0};
+  size_t nframes{0};
+  while (offset < a_compressed.size()) {
+    raw.clear();
+    const size_t nbytes = compression::decompress_member(
+        a_compressed.substr(offset), a_codec, raw);
+    // Throws on a frame cut by the end of the member
+    const ConIndex index{raw};
+    blocks.push_back({offset, nbytes, nframes, index.size(), raw.size()});
+    offset += nbytes;
+    nframes += index.size();
+  }
+  return blocks;
+}
+
+SeekableReader::SeekableReader(const std::string &a_fname, bool a_write)
+    : m_mapped{a_fname}, m_codec{compression::detect_codec(m_mapped.view())},
+      m_cached_block{NoBlock} {
+  if (m_codec == compression::Codec::None) {
+    throw std::runtime_error(a_fname + " is not compressed");
+  }
+  if (!compression::is_supported(m_codec)) {
+    throw std::runtime_error(
+        std::string{"Support for "} +
+        std::string{compression::codec_name(m_codec)} +
+        " was not enabled at build time");
+  }
+  auto stored = read_sidecar(a_fname, m_codec, m_mapped.size());
+  if (stored.has_value()) {
+    m_blocks = std::move(stored.value());
+  } else {
+    m_blocks = build_blocks(m_mapped.view(), m_codec);
+    if (a_write) {
+      write_sidecar(a_fname, m_codec, m_blocks);
+    }
+  }
+  if (!m_blocks.empty()) {
+    m_nframes = m_blocks.back().first_frame + m_blocks.back().nframes;
+  }
+}
+
+size_t SeekableReader::block_of(size_t a_idx) const {
+  if (a_idx >= m_nframes) {
+    throw std::out_of_range("Frame " + std::to_string(a_idx) +
+                            " is past the last frame");
+  }
+  auto after = std::upper_bound(
+      m_blocks.begin(), m_blocks.end(), a_idx,
+      [](size_t a_frame, const BlockEntry &a_block) {
+        return a_frame < a_block.first_frame;
+      });
+  return static_cast<size_t>(std::distance(m_blocks.begin(), after)) - 1;
+}
+
+std::string_view SeekableReader::frame_view(size_t a_idx) {
+  const size_t blk = block_of(a_idx);
+  if (blk != m_cached_block) {
+    const auto &block = m_blocks[blk];
+    m_cached_block = NoBlock;
+    m_block.clear();
+    m_block.reserve(block.raw_bytes);
+    compression::decompress_member(
+        m_mapped.view().substr(block.offset, block.nbytes), m_codec, m_block);
+    m_block_index = ConIndex{m_block};
+    if (m_block_index.size() != block.nframes) {
+      throw std::invalid_argument("Block " + std::to_string(blk) +
+                                  " does not match the block index");
+    }
+    m_cached_block = blk;
+  }
+  return m_block_index.frame_view(a_idx - m_blocks[blk].first_frame);
+}
+} // namespace yodecon::seekable
@@ -0,0 +1,59 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <iterator>
+
+#include "readCon/include/ConSummary.hpp"
+#include "readCon/include/Compression.hpp"
+#include "readCon/include/ConIndex.hpp"
+#include "readCon/include/ConIndexFile.hpp"
+
+namespace yodecon {
+namespace {
+void append_frame(types::ConSummary &a_summary,
+                  const types::FrameOffset &a_entry) {
+  a_summary.natoms.push_back(a_entry.natoms);
+  a_summary.natm_types.push_back(a_entry.natm_types);
+  a_summary.boxl.push_back(a_entry.boxl);
+  a_summary.angles.push_back(a_entry.angles);
+}
+} // namespace
+
+types::ConSummary scan_con(std::string_view a_fconts) {
+  types::ConSummary summary;
+  helpers::string::LineCursor cursor{a_fconts};
+  types::FrameOffset entry{};
+  while (!cursor.at_end()) {
+    if (!scan_frame(cursor, entry)) {
+      throw std::invalid_argument("Truncated frame at byte offset " +
+                                  std::to_string(entry.offset));
+    }
+    append_frame(summary, entry);
+  }
+  return summary;
+}
+
+types::ConSummary
+summarize_frames(const std::vector<types::FrameOffset> &a_frames) {
+  types::ConSummary summary;
+  summary.natoms.reserve(a_frames.size());
+  summary.natm_types.reserve(a_frames.size());
+  summary.boxl.reserve(a_frames.size());
+  summary.angles.reserve(a_frames.size());
+  for (const auto &entry : a_frames) {
+    append_frame(summary, entry);
+  }
+  return summary;
+}
+
+types::ConSummary scan_con_file(const std::string &a_fname) {
+  if (compression::detect_codec_of(a_fname) != compression::Codec::None) {
+    // Offsets into compressed bytes are meaningless, so no sidecar either
+    auto input = compression::open_input(a_fname);
+    const std::string text{std::istreambuf_iterator<char>{*input}, {}};
+    return scan_con(text);
+  }
+  helpers::file::MappedFile mapped{a_fname};
+  return summarize_frames(
+      idxfile::load_or_build(a_fname, mapped.view(), false).frames());
+}
+} // namespace yodecon
@@ -1,93 +1,448 @@
 // MIT License
 // Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <utility>
+
 #include "readCon/include/ReadCon.hpp"
 
 namespace yodecon {
+namespace {
+// Pulls the next line of a coordinate block, the frame is truncated otherwise
+std::string_view
+next_coordinate_line(yodecon::helpers::string::LineCursor &a_cursor) {
+  std::string_view line;
+  if (!a_cursor.next(line)) {
+    throw std::invalid_argument(
+        "Unexpected end of input within a coordinate block");
+  }
+  return line;
+}
+
+// The numeric fields of an atom line, positions converted straight to Real
+template <typename Real> struct AtomLine {
+  std::array<Real, 3> pos{};
+  double is_fixed{0};
+  double atom_id{0};
+};
+
+// Same semantics as get_array_from_string<double, 5>, but converts positions
+// directly into Real, so float frames are correctly rounded and never pass
+// through a double
+template <typename Real>
+AtomLine<Real> parse_atom_line(std::string_view a_line,
+                               yodecon::policy::Lenient /*unused*/) {
+  if (a_line.empty()) {
+    throw std::invalid_argument("Line must not be empty.");
+  }
+  AtomLine<Real> result;
+  std::string_view token;
+  size_t idx{0};
+  while (idx < 5 && yodecon::helpers::string::next_token(a_line, token)) {
+    const bool converted =
+        idx < 3 ? yodecon::helpers::string::parse_token(token, result.pos[idx])
+        : idx == 3
+            ? yodecon::helpers::string::parse_token(token, result.is_fixed)
+            : yodecon::helpers::string::parse_token(token, result.atom_id);
+    if (converted) {
+      idx++;
+    }
+  }
+  return result;
+}
+
+// Whole token conversion, without the leniencies of parse_token
+template <typename T> bool parse_exact(std::string_view a_token, T &a_value) {
+  const char *last = a_token.data() + a_token.size();
+  auto [ptr, ec] = std::from_chars(a_token.data(), last, a_value);
+  return ec == std::errc{} && ptr == last && !a_token.empty();
+}
+
+template <typename Real>
+AtomLine<Real> parse_atom_line(std::string_view a_line,
+                               yodecon::policy::Strict /*unused*/) {
+  const std::string_view line{a_line};
+  AtomLine<Real> result;
+  std::array<int, 2> flags{};
+  std::string_view token;
+  size_t idx{0};
+  for (; yodecon::helpers::string::next_token(a_line, token); idx++) {
+    if (idx == 5) {
+      throw std::invalid_argument("Atom line has more than 5 fields: " +
+                                  std::string{line});
+    }
+    const bool converted = idx < 3 ? parse_exact(token, result.pos[idx])
+                                   : parse_exact(token, flags[idx - 3]);
+    if (!converted) {
+      throw std::invalid_argument("Invalid number in atom line: " +
+                                  std::string{line});
+    }
+  }
+  if (idx < 5) {
+    throw std::invalid_argument("Atom line has too few fields: " +
+                                std::string{line});
+  }
+  if (flags[0] != 0 && flags[0] != 1) {
+    throw std::invalid_argument("Fixed flag must be 0 or 1: " +
+                                std::string{line});
+  }
+  result.is_fixed = flags[0];
+  result.atom_id = flags[1];
+  return result;
+}
+
+template <typename Real>
+AtomLine<Real> parse_atom_line(std::string_view a_line,
+                               yodecon::policy::Trusted /*unused*/) {
+  AtomLine<Real> result;
+  std::array<int, 2> flags{};
+  std::string_view token;
+  for (size_t idx{0}; idx < 3; idx++) {
+    yodecon::helpers::string::next_token(a_line, token);
+    std::from_chars(token.data(), token.data() + token.size(),
+                    result.pos[idx]);
+  }
+  for (auto &flag : flags) {
+    yodecon::helpers::string::next_token(a_line, token);
+    std::from_chars(token.data(), token.data() + token.size(), flag);
+  }
+  result.is_fixed = flags[0];
+  result.atom_id = flags[1];
+  return result;
+}
+
+// Sizes every per atom destination exactly once, from the header counts
+template <typename AtomT>
+size_t resize_atoms(yodecon::types::BasicConFrame<AtomT> &conframe) {
+  const size_t natoms = std::accumulate(conframe.natms_per_type.begin(),
+                                        conframe.natms_per_type.end(),
+                                        size_t{0});
+  conframe.atom_data.resize(natoms);
+  return natoms;
+}
+
+template <typename Real>
+size_t resize_atoms(yodecon::types::BasicConFrameVec<Real> &conframevec) {
+  const size_t natoms = std::accumulate(conframevec.natms_per_type.begin(),
+                                        conframevec.natms_per_type.end(),
+                                        size_t{0});
+  conframevec.symbol.resize(natoms);
+  conframevec.x.resize(natoms);
+  conframevec.y.resize(natoms);
+  conframevec.z.resize(natoms);
+  conframevec.is_fixed.resize(natoms);
+  conframevec.atom_id.resize(natoms);
+  return natoms;
+}
+
+size_t resize_atoms(yodecon::types::ConFrameVecTyped &conframevec) {
+  using type_index_t = yodecon::types::ConFrameVecTyped::type_index_t;
+  if (conframevec.natm_types > std::numeric_limits<type_index_t>::max()) {
+    throw std::invalid_argument("Too many components for ConFrameVecTyped");
+  }
+  const size_t natoms = std::accumulate(conframevec.natms_per_type.begin(),
+                                        conframevec.natms_per_type.end(),
+                                        size_t{0});
+  conframevec.type_symbols.resize(conframevec.natm_types);
+  conframevec.type_index.resize(natoms);
+  conframevec.x.resize(natoms);
+  conframevec.y.resize(natoms);
+  conframevec.z.resize(natoms);
+  conframevec.is_fixed.resize(natoms);
+  conframevec.atom_id.resize(natoms);
+  return natoms;
+}
+
+// Sizes only the columns selected by a_mask, the others are emptied. Passing
+// a_clear as false shrinks filled columns while keeping their contents.
+template <typename Real>
+void resize_columns(yodecon::types::BasicConFrameVec<Real> &conframevec,
+                    size_t a_natoms, unsigned a_mask, bool a_clear = true) {
+  auto fit = [&](auto &a_column, unsigned a_flag) {
+    if (a_clear) {
+      a_column.clear();
+    }
+    if ((a_mask & a_flag) != 0) {
+      a_column.resize(a_natoms);
+    }
+  };
+  fit(conframevec.symbol, yodecon::columns::Symbol);
+  fit(conframevec.x, yodecon::columns::X);
+  fit(conframevec.y, yodecon::columns::Y);
+  fit(conframevec.z, yodecon::columns::Z);
+  fit(conframevec.is_fixed, yodecon::columns::IsFixed);
+  fit(conframevec.atom_id, yodecon::columns::AtomId);
+}
+
+// Fields of an atom line, in order
+constexpr std::array<unsigned, 5> LineFields{
+    yodecon::columns::X, yodecon::columns::Y, yodecon::columns::Z,
+    yodecon::columns::IsFixed, yodecon::columns::AtomId};
+
+// Converts the fields of an atom line selected by a_mask, by position, and
+// stops tokenizing after the last selected one
+template <typename Real>
+void scan_selected_fields(std::string_view a_line, unsigned a_mask,
+                          AtomLine<Real> &a_out) {
+  size_t nfields{0};
+  for (size_t idx{0}; idx < LineFields.size(); ++idx) {
+    if ((a_mask & LineFields[idx]) != 0) {
+      nfields = idx + 1;
+    }
+  }
+  std::string_view token;
+  for (size_t idx{0}; idx < nfields; ++idx) {
+    if (!yodecon::helpers::string::next_token(a_line, token)) {
+      throw std::invalid_argument("Atom line has too few fields");
+    }
+    if ((a_mask & LineFields[idx]) == 0) {
+      continue;
+    }
+    const bool converted =
+        idx < 3 ? yodecon::helpers::string::parse_token(token, a_out.pos[idx])
+        : idx == 3
+            ? yodecon::helpers::string::parse_token(token, a_out.is_fixed)
+            : yodecon::helpers::string::parse_token(token, a_out.atom_id);
+    if (!converted) {
+      throw std::invalid_argument("Invalid number in atom line: " +
+                                  std::string{token});
+    }
+  }
+}
+
+// Element of a component header line, looked up once per component
+std::uint8_t component_atomic_number(std::string_view a_symbol) {
+  const auto &numbers = yodecon::types::known_info::AtomicNumbers;
+  auto found = numbers.find(std::string{a_symbol});
+  if (found == numbers.end()) {
+    throw std::invalid_argument("Invalid element symbol: " +
+                                std::string{a_symbol});
+  }
+  return static_cast<std::uint8_t>(found->second);
+}
+
+// Every atom line takes at least two bytes, reject headers claiming more atoms
+// than could possibly follow before allocating for them
+void check_atom_count(const std::vector<size_t> &a_natms_per_type,
+                      const yodecon::helpers::string::LineCursor &a_cursor) {
+  const size_t natoms = std::accumulate(a_natms_per_type.begin(),
+                                        a_natms_per_type.end(), size_t{0});
+  if (natoms > (a_cursor.remaining() + 1) / 2) {
+    throw std::invalid_argument(
+        "Unexpected end of input within a coordinate block");
+  }
+}
+
+void skip_coordinate_lines(yodecon::helpers::string::LineCursor &a_cursor,
+                           size_t a_nlines) {
+  if (a_cursor.skip(a_nlines) != a_nlines) {
+    throw std::invalid_argument(
+        "Unexpected end of input within a coordinate block");
+  }
+}
+
+// Components kept by the symbol filter, and an upper bound on the kept atoms
+struct Selection {
+  std::vector<bool> keep;
+  size_t max_atoms{0};
+};
+
+// Peeks at the component header lines only, skipping the atom lines by count,
+// so that the destinations can be sized once before parsing
+Selection select_components(yodecon::helpers::string::LineCursor a_cursor,
+                            const std::vector<size_t> &a_natms_per_type,
+                            const yodecon::ParseOptions &a_opts) {
+  Selection sel;
+  sel.keep.resize(a_natms_per_type.size());
+  for (size_t idx{0}; idx < a_natms_per_type.size(); ++idx) {
+    const std::string_view symbol = next_coordinate_line(a_cursor);
+    sel.keep[idx] =
+        a_opts.symbols.empty() ||
+        std::find(a_opts.symbols.begin(), a_opts.symbols.end(), symbol) !=
+            a_opts.symbols.end();
+    if (sel.keep[idx]) {
+      sel.max_atoms += a_natms_per_type[idx];
+    }
+    skip_coordinate_lines(a_cursor, 1 + a_natms_per_type[idx]);
+  }
+  return sel;
+}
+
+// Parses the coordinate blocks, skipping the components rejected by a_sel
+// without converting them, and hands each kept atom to
+// a_store(index, symbol, fields). Only a_fields, plus the atom id when
+// filtering on it, are converted. When atoms are filtered the header counts
+// are rewritten to describe the kept atoms, dropping emptied components.
+template <typename Real, typename ConFrameLike, typename StoreFn>
+size_t walk_selected(yodecon::helpers::string::LineCursor &a_cursor,
+                     ConFrameLike &a_frame, const Selection &a_sel,
+                     const yodecon::ParseOptions &a_opts, unsigned a_fields,
+                     StoreFn &&a_store) {
+  const unsigned convert =
+      a_fields | (a_opts.atom_ids ? yodecon::columns::AtomId : 0U);
+  AtomLine<Real> vals{};
+  std::vector<size_t> natms_kept;
+  std::vector<double> masses_kept;
+  size_t atm_idx{0};
+  for (size_t idx{0}; idx < a_frame.natm_types; ++idx) {
+    const std::string_view symbol = next_coordinate_line(a_cursor);
+    next_coordinate_line(a_cursor); // Coordinates of Component N
+    const size_t natms = a_frame.natms_per_type[idx];
+    if (!a_sel.keep[idx]) {
+      skip_coordinate_lines(a_cursor, natms);
+      continue;
+    }
+    const size_t first{atm_idx};
+    if (convert == 0) {
+      skip_coordinate_lines(a_cursor, natms);
+      for (size_t natm{0}; natm < natms; ++natm) {
+        a_store(atm_idx++, symbol, vals);
+      }
+    } else {
+      for (size_t natm{0}; natm < natms; ++natm) {
+        scan_selected_fields(next_coordinate_line(a_cursor), convert, vals);
+        if (a_opts.atom_ids && (vals.atom_id < a_opts.atom_ids->first ||
+                                vals.atom_id > a_opts.atom_ids->second)) {
+          continue;
+        }
+        a_store(atm_idx++, symbol, vals);
+      }
+    }
+    if (atm_idx > first) {
+      natms_kept.push_back(atm_idx - first);
+      masses_kept.push_back(idx < a_frame.masses_per_type.size()
+                                ? a_frame.masses_per_type[idx]
+                                : 0.0);
+    }
+  }
+  if (a_opts.filters_atoms()) {
+    a_frame.natm_types = natms_kept.size();
+    a_frame.natms_per_type = std::move(natms_kept);
+    a_frame.masses_per_type = std::move(masses_kept);
+  }
+  return atm_idx;
+}
+} // namespace
+
 #ifdef WITH_RANGE_V3
-void process_coordinates(const std::vector<std::string> &a_filecontents,
-                         yodecon::types::ConFrame &conframe) {
-  types::AtomDatum tmp_atm;
+template <typename Real>
+void process_coordinates(
+    const std::vector<std::string> &a_filecontents,
+    yodecon::types::BasicConFrame<types::BasicAtomDatum<Real>> &conframe) {
+  resize_atoms(conframe);
+  size_t atm_idx{0};
   size_t drop_amount = constants::HeaderLength;
   for (size_t idx{0}; idx < conframe.natm_types; idx++) {
     size_t natms = conframe.natms_per_type[idx];
     size_t take_amount = natms + constants::CoordHeader;
+    if (drop_amount + take_amount > a_filecontents.size()) {
+      throw std::invalid_argument(
+          "Unexpected end of input within a coordinate block");
+    }
     auto coords_view = a_filecontents | ranges::views::drop(drop_amount) |
                        ranges::views::take(take_amount);
-    tmp_atm.symbol = coords_view[0];
+    const std::string &symbol = coords_view[0];
     for (auto &&line :
          coords_view | ranges::views::drop(constants::CoordHeader)) {
-      auto dbl_line = helpers::string::get_array_from_string<double, 5>(line);
-      tmp_atm.x = dbl_line[0];
-      tmp_atm.y = dbl_line[1];
-      tmp_atm.z = dbl_line[2];
-      tmp_atm.is_fixed = static_cast<bool>(dbl_line[3]);
-      tmp_atm.atom_id = static_cast<size_t>(dbl_line[4]);
-      conframe.atom_data.push_back(tmp_atm);
+      const auto fields = parse_atom_line<Real>(line, policy::Lenient{});
+      auto &atm = conframe.atom_data[atm_idx++];
+      atm.symbol = symbol;
+      atm.x = fields.pos[0];
+      atm.y = fields.pos[1];
+      atm.z = fields.pos[2];
+      atm.is_fixed = static_cast<bool>(fields.is_fixed);
+      atm.atom_id = static_cast<int>(fields.atom_id);
     }
     drop_amount += take_amount;
   }
 }
 
+template <typename Real>
 void process_coordinates(const std::vector<std::string> &a_filecontents,
-                         yodecon::types::ConFrameVec &conframevec) {
-  types::AtomDatum tmp_atm;
+                         yodecon::types::BasicConFrameVec<Real> &conframevec) {
+  resize_atoms(conframevec);
+  size_t atm_idx{0};
   size_t drop_amount = constants::HeaderLength;
   for (size_t idx{0}; idx < conframevec.natm_types; idx++) {
     size_t natms = conframevec.natms_per_type[idx];
     size_t take_amount = natms + constants::CoordHeader;
+    if (drop_amount + take_amount > a_filecontents.size()) {
+      throw std::invalid_argument(
+          "Unexpected end of input within a coordinate block");
+    }
     auto coords_view = a_filecontents | ranges::views::drop(drop_amount) |
                        ranges::views::take(take_amount);
     for (auto &&line :
          coords_view | ranges::views::drop(constants::CoordHeader)) {
-      conframevec.symbol.push_back(coords_view[0]);
-      auto dbl_line = helpers::string::get_array_from_string<double, 5>(line);
-      conframevec.x.push_back(dbl_line[0]);
-      conframevec.y.push_back(dbl_line[1]);
-      conframevec.z.push_back(dbl_line[2]);
-      conframevec.is_fixed.push_back(static_cast<bool>(dbl_line[3]));
-      conframevec.atom_id.push_back(static_cast<size_t>(dbl_line[4]));
+      conframevec.symbol[atm_idx] = coords_view[0];
+      const auto fields = parse_atom_line<Real>(line, policy::Lenient{});
+      conframevec.x[atm_idx] = fields.pos[0];
+      conframevec.y[atm_idx] = fields.pos[1];
+      conframevec.z[atm_idx] = fields.pos[2];
+      conframevec.is_fixed[atm_idx] = static_cast<bool>(fields.is_fixed);
+      conframevec.atom_id[atm_idx] = static_cast<int>(fields.atom_id);
+      atm_idx++;
     }
     drop_amount += take_amount;
   }
 }
 #else
 
-void process_coordinates(const std::vector<std::string> &a_filecontents,
-                         yodecon::types::ConFrame &conframe) {
-  types::AtomDatum tmp_atm;
+template <typename Real>
+void process_coordinates(
+    const std::vector<std::string> &a_filecontents,
+    yodecon::types::BasicConFrame<types::BasicAtomDatum<Real>> &conframe) {
+  resize_atoms(conframe);
+  size_t atm_idx{0};
   size_t drop_amount = constants::HeaderLength;
   for (size_t idx = 0; idx < conframe.natm_types; ++idx) {
     size_t natms = conframe.natms_per_type[idx];
     size_t take_amount = natms + constants::CoordHeader;
+    if (drop_amount + take_amount > a_filecontents.size()) {
+      throw std::invalid_argument(
+          "Unexpected end of input within a coordinate block");
+    }
 
     // Use take and drop functions to create the coordinates view
     auto coords_view =
         norange::take(norange::drop(a_filecontents, drop_amount), take_amount);
 
-    tmp_atm.symbol = coords_view[0];
     // Skip the header and process the rest of the lines
     for (size_t line_idx = constants::CoordHeader;
          line_idx < coords_view.size(); ++line_idx) {
       const auto &line = coords_view[line_idx];
-      auto dbl_line = helpers::string::get_array_from_string<double, 5>(line);
-      tmp_atm.x = dbl_line[0];
-      tmp_atm.y = dbl_line[1];
-      tmp_atm.z = dbl_line[2];
-      tmp_atm.is_fixed = static_cast<bool>(dbl_line[3]);
-      tmp_atm.atom_id = static_cast<size_t>(dbl_line[4]);
-      conframe.atom_data.push_back(tmp_atm);
+      const auto fields = parse_atom_line<Real>(line, policy::Lenient{});
+      auto &atm = conframe.atom_data[atm_idx++];
+      atm.symbol = coords_view[0];
+      atm.x = fields.pos[0];
+      atm.y = fields.pos[1];
+      atm.z = fields.pos[2];
+      atm.is_fixed = static_cast<bool>(fields.is_fixed);
+      atm.atom_id = static_cast<int>(fields.atom_id);
     }
     drop_amount += take_amount;
   }
 }
 
+template <typename Real>
 void process_coordinates(const std::vector<std::string> &a_filecontents,
-                         yodecon::types::ConFrameVec &conframevec) {
+                         yodecon::types::BasicConFrameVec<Real> &conframevec) {
+  resize_atoms(conframevec);
+  size_t atm_idx{0};
   size_t drop_amount = constants::HeaderLength;
 
   for (size_t idx = 0; idx < conframevec.natm_types; ++idx) {
     size_t natms = conframevec.natms_per_type[idx];
     size_t take_amount = natms + constants::CoordHeader;
+    if (drop_amount + take_amount > a_filecontents.size()) {
+      throw std::invalid_argument(
+          "Unexpected end of input within a coordinate block");
+    }
 
     // Create a sub-vector for each atom type, dropping the previous data and
     // taking the relevant lines
@@ -98,14 +453,15 @@ void process_coordinates(const std::vector<std::string> &a_filecontents,
     for (size_t line_idx = constants::CoordHeader;
          line_idx < coords_view.size(); ++line_idx) {
       const std::string &line = coords_view[line_idx];
-      auto dbl_line = helpers::string::get_array_from_string<double, 5>(line);
+      const auto fields = parse_atom_line<Real>(line, policy::Lenient{});
 
-      conframevec.symbol.push_back(coords_view[0]);
-      conframevec.x.push_back(dbl_line[0]);
-      conframevec.y.push_back(dbl_line[1]);
-      conframevec.z.push_back(dbl_line[2]);
-      conframevec.is_fixed.push_back(static_cast<bool>(dbl_line[3]));
-      conframevec.atom_id.push_back(static_cast<size_t>(dbl_line[4]));
+      conframevec.symbol[atm_idx] = coords_view[0];
+      conframevec.x[atm_idx] = fields.pos[0];
+      conframevec.y[atm_idx] = fields.pos[1];
+      conframevec.z[atm_idx] = fields.pos[2];
+      conframevec.is_fixed[atm_idx] = static_cast<bool>(fields.is_fixed);
+      conframevec.atom_id[atm_idx] = static_cast<int>(fields.atom_id);
+      atm_idx++;
     }
 
     drop_amount += take_amount; // Update the drop amount for the next iteration
@@ -114,6 +470,225 @@ void process_coordinates(const std::vector<std::string> &a_filecontents,
 
 #endif
 
+template <typename Policy, typename Real>
+void process_coordinates(
+    yodecon::helpers::string::LineCursor &a_cursor,
+    yodecon::types::BasicConFrame<types::BasicAtomDatum<Real>> &conframe) {
+  check_atom_count(conframe.natms_per_type, a_cursor);
+  resize_atoms(conframe);
+  auto atm = conframe.atom_data.begin();
+  for (size_t idx = 0; idx < conframe.natm_types; ++idx) {
+    const std::string_view symbol = next_coordinate_line(a_cursor);
+    next_coordinate_line(a_cursor); // Coordinates of Component N
+    for (size_t natm = 0; natm < conframe.natms_per_type[idx]; ++natm, ++atm) {
+      const auto fields =
+          parse_atom_line<Real>(next_coordinate_line(a_cursor), Policy{});
+      atm->symbol = symbol;
+      atm->x = fields.pos[0];
+      atm->y = fields.pos[1];
+      atm->z = fields.pos[2];
+      atm->is_fixed = static_cast<bool>(fields.is_fixed);
+      atm->atom_id = static_cast<int>(fields.atom_id);
+    }
+  }
+}
+
+template <typename Policy, typename Real>
+void process_coordinates(yodecon::helpers::string::LineCursor &a_cursor,
+                         yodecon::types::BasicConFrameVec<Real> &conframevec) {
+  check_atom_count(conframevec.natms_per_type, a_cursor);
+  resize_atoms(conframevec);
+  size_t atm_idx{0};
+  for (size_t idx = 0; idx < conframevec.natm_types; ++idx) {
+    const std::string_view symbol = next_coordinate_line(a_cursor);
+    next_coordinate_line(a_cursor); // Coordinates of Component N
+    const size_t natms = conframevec.natms_per_type[idx];
+    // Short symbols fit the small string buffer, so this does not allocate
+    std::fill_n(conframevec.symbol.begin() + atm_idx, natms,
+                std::string{symbol});
+    for (size_t natm = 0; natm < natms; ++natm, ++atm_idx) {
+      const auto fields =
+          parse_atom_line<Real>(next_coordinate_line(a_cursor), Policy{});
+      conframevec.x[atm_idx] = fields.pos[0];
+      conframevec.y[atm_idx] = fields.pos[1];
+      conframevec.z[atm_idx] = fields.pos[2];
+      conframevec.is_fixed[atm_idx] = static_cast<bool>(fields.is_fixed);
+      conframevec.atom_id[atm_idx] = static_cast<int>(fields.atom_id);
+    }
+  }
+}
+
+void process_coordinates(const std::vector<std::string> &a_filecontents,
+                         yodecon::types::ConFrameVecTyped &conframevec) {
+  resize_atoms(conframevec);
+  size_t atm_idx{0};
+  size_t line_idx = constants::HeaderLength;
+  for (size_t idx = 0; idx < conframevec.natm_types; ++idx) {
+    if (line_idx + constants::CoordHeader + conframevec.natms_per_type[idx] >
+        a_filecontents.size()) {
+      throw std::invalid_argument(
+          "Unexpected end of input within a coordinate block");
+    }
+    conframevec.type_symbols[idx] = a_filecontents[line_idx];
+    line_idx += constants::CoordHeader;
+    for (size_t natm = 0; natm < conframevec.natms_per_type[idx];
+         ++natm, ++atm_idx) {
+      auto dbl_line = helpers::string::get_array_from_string<double, 5>(
+          a_filecontents[line_idx++]);
+      conframevec.type_index[atm_idx] =
+          static_cast<types::ConFrameVecTyped::type_index_t>(idx);
+      conframevec.x[atm_idx] = dbl_line[0];
+      conframevec.y[atm_idx] = dbl_line[1];
+      conframevec.z[atm_idx] = dbl_line[2];
+      conframevec.is_fixed[atm_idx] = static_cast<bool>(dbl_line[3]);
+      conframevec.atom_id[atm_idx] = static_cast<size_t>(dbl_line[4]);
+    }
+  }
+}
+
+template <typename Policy>
+void process_coordinates(yodecon::helpers::string::LineCursor &a_cursor,
+                         yodecon::types::ConFrameVecTyped &conframevec) {
+  check_atom_count(conframevec.natms_per_type, a_cursor);
+  resize_atoms(conframevec);
+  size_t atm_idx{0};
+  for (size_t idx = 0; idx < conframevec.natm_types; ++idx) {
+    conframevec.type_symbols[idx] = next_coordinate_line(a_cursor);
+    next_coordinate_line(a_cursor); // Coordinates of Component N
+    const size_t natms = conframevec.natms_per_type[idx];
+    std::fill_n(conframevec.type_index.begin() + atm_idx, natms,
+                static_cast<types::ConFrameVecTyped::type_index_t>(idx));
+    for (size_t natm = 0; natm < natms; ++natm, ++atm_idx) {
+      const auto fields =
+          parse_atom_line<double>(next_coordinate_line(a_cursor), Policy{});
+      conframevec.x[atm_idx] = fields.pos[0];
+      conframevec.y[atm_idx] = fields.pos[1];
+      conframevec.z[atm_idx] = fields.pos[2];
+      conframevec.is_fixed[atm_idx] = static_cast<bool>(fields.is_fixed);
+      conframevec.atom_id[atm_idx] = static_cast<size_t>(fields.atom_id);
+    }
+  }
+}
+
+void process_coordinates(const std::vector<std::string> &a_filecontents,
+                         yodecon::types::ConFrameCompact &conframe) {
+  resize_atoms(conframe);
+  auto atm = conframe.atom_data.begin();
+  size_t line_idx = constants::HeaderLength;
+  for (size_t idx = 0; idx < conframe.natm_types; ++idx) {
+    if (line_idx + constants::CoordHeader + conframe.natms_per_type[idx] >
+        a_filecontents.size()) {
+      throw std::invalid_argument(
+          "Unexpected end of input within a coordinate block");
+    }
+    const auto atomic_number =
+        component_atomic_number(a_filecontents[line_idx]);
+    line_idx += constants::CoordHeader;
+    for (size_t natm = 0; natm < conframe.natms_per_type[idx]; ++natm, ++atm) {
+      auto dbl_line = helpers::string::get_array_from_string<double, 5>(
+          a_filecontents[line_idx++]);
+      *atm = types::AtomDatumCompact{atomic_number,
+                                     dbl_line[0],
+                                     dbl_line[1],
+                                     dbl_line[2],
+                                     static_cast<bool>(dbl_line[3]),
+                                     static_cast<int>(dbl_line[4])};
+    }
+  }
+}
+
+template <typename Policy>
+void process_coordinates(yodecon::helpers::string::LineCursor &a_cursor,
+                         yodecon::types::ConFrameCompact &conframe) {
+  check_atom_count(conframe.natms_per_type, a_cursor);
+  resize_atoms(conframe);
+  auto atm = conframe.atom_data.begin();
+  for (size_t idx = 0; idx < conframe.natm_types; ++idx) {
+    const auto atomic_number =
+        component_atomic_number(next_coordinate_line(a_cursor));
+    next_coordinate_line(a_cursor); // Coordinates of Component N
+    for (size_t natm = 0; natm < conframe.natms_per_type[idx]; ++natm, ++atm) {
+      const auto fields =
+          parse_atom_line<double>(next_coordinate_line(a_cursor), Policy{});
+      *atm = types::AtomDatumCompact{atomic_number,
+                                     fields.pos[0],
+                                     fields.pos[1],
+                                     fields.pos[2],
+                                     static_cast<bool>(fields.is_fixed),
+                                     static_cast<int>(fields.atom_id)};
+    }
+  }
+}
+
+template <typename Real>
+void process_coordinates(
+    yodecon::helpers::string::LineCursor &a_cursor,
+    yodecon::types::BasicConFrame<types::BasicAtomDatum<Real>> &conframe,
+    const yodecon::ParseOptions &a_opts) {
+  if (!a_opts.filters_atoms()) {
+    process_coordinates(a_cursor, conframe);
+    return;
+  }
+  check_atom_count(conframe.natms_per_type, a_cursor);
+  const auto sel =
+      select_components(a_cursor, conframe.natms_per_type, a_opts);
+  conframe.atom_data.resize(sel.max_atoms);
+  const size_t nkept = walk_selected<Real>(
+      a_cursor, conframe, sel, a_opts, columns::All & ~columns::Symbol,
+      [&](size_t a_idx, std::string_view a_symbol,
+          const AtomLine<Real> &a_vals) {
+        auto &atm = conframe.atom_data[a_idx];
+        atm.symbol = a_symbol;
+        atm.x = a_vals.pos[0];
+        atm.y = a_vals.pos[1];
+        atm.z = a_vals.pos[2];
+        atm.is_fixed = static_cast<bool>(a_vals.is_fixed);
+        atm.atom_id = static_cast<int>(a_vals.atom_id);
+      });
+  conframe.atom_data.resize(nkept);
+}
+
+template <typename Real>
+void process_coordinates(yodecon::helpers::string::LineCursor &a_cursor,
+                         yodecon::types::BasicConFrameVec<Real> &conframevec,
+                         const yodecon::ParseOptions &a_opts) {
+  const unsigned mask = a_opts.columns & columns::All;
+  if (mask == columns::All && !a_opts.filters_atoms()) {
+    process_coordinates(a_cursor, conframevec);
+    return;
+  }
+  check_atom_count(conframevec.natms_per_type, a_cursor);
+  const auto sel =
+      select_components(a_cursor, conframevec.natms_per_type, a_opts);
+  resize_columns(conframevec, sel.max_atoms, mask);
+  const size_t nkept = walk_selected<Real>(
+      a_cursor, conframevec, sel, a_opts, mask & ~columns::Symbol,
+      [&](size_t a_idx, std::string_view a_symbol,
+          const AtomLine<Real> &a_vals) {
+        if ((mask & columns::Symbol) != 0) {
+          conframevec.symbol[a_idx] = a_symbol;
+        }
+        if ((mask & columns::X) != 0) {
+          conframevec.x[a_idx] = a_vals.pos[0];
+        }
+        if ((mask & columns::Y) != 0) {
+          conframevec.y[a_idx] = a_vals.pos[1];
+        }
+        if ((mask & columns::Z) != 0) {
+          conframevec.z[a_idx] = a_vals.pos[2];
+        }
+        if ((mask & columns::IsFixed) != 0) {
+          conframevec.is_fixed[a_idx] = static_cast<bool>(a_vals.is_fixed);
+        }
+        if ((mask & columns::AtomId) != 0) {
+          conframevec.atom_id[a_idx] = static_cast<int>(a_vals.atom_id);
+        }
+      });
+  if (nkept < sel.max_atoms) {
+    resize_columns(conframevec, nkept, mask, false);
+  }
+}
+
 std::vector<int>
 symbols_to_atomic_numbers(const std::vector<std::string> &a_symbols) {
   return yodecon::helpers::con::convert_keys_to_values<std::string, int>(
@@ -128,4 +703,99 @@ atomic_numbers_to_symbols(const std::vector<int> &a_atomic_numbers) {
       "Invalid atomic number");
 }
 
+std::vector<int>
+symbols_to_atomic_numbers(const yodecon::types::ConFrameVecTyped &a_frame) {
+  const auto per_type = symbols_to_atomic_numbers(a_frame.type_symbols);
+  std::vector<int> result(a_frame.type_index.size());
+  std::transform(a_frame.type_index.begin(), a_frame.type_index.end(),
+                 result.begin(), [&](auto a_idx) { return per_type[a_idx]; });
+  return result;
+}
+
+namespace {
+// Copies everything but the atoms, which differ between the layouts
+template <typename ToFrame, typename FromFrame>
+ToFrame copy_frame_header(const FromFrame &a_frame) {
+  ToFrame result;
+  result.prebox_header = a_frame.prebox_header;
+  result.boxl = a_frame.boxl;
+  result.angles = a_frame.angles;
+  result.postbox_header = a_frame.postbox_header;
+  result.natm_types = a_frame.natm_types;
+  result.natms_per_type = a_frame.natms_per_type;
+  result.masses_per_type = a_frame.masses_per_type;
+  result.atom_data.reserve(a_frame.atom_data.size());
+  return result;
+}
+} // namespace
+
+yodecon::types::ConFrameCompact
+to_compact(const yodecon::types::ConFrame &a_frame) {
+  auto result = copy_frame_header<types::ConFrameCompact>(a_frame);
+  // Atoms of a component are contiguous, only look up symbol changes
+  const std::string *last_symbol{nullptr};
+  std::uint8_t atomic_number{0};
+  for (const auto &atm : a_frame.atom_data) {
+    if (last_symbol == nullptr || atm.symbol != *last_symbol) {
+      atomic_number = component_atomic_number(atm.symbol);
+      last_symbol = &atm.symbol;
+    }
+    result.atom_data.emplace_back(atomic_number, atm.x, atm.y, atm.z,
+                                  atm.is_fixed, atm.atom_id);
+  }
+  return result;
+}
+
+yodecon::types::ConFrame
+from_compact(const yodecon::types::ConFrameCompact &a_frame) {
+  auto result = copy_frame_header<types::ConFrame>(a_frame);
+  const auto &symbols = yodecon::types::known_info::AtomicSymbols;
+  for (const auto &atm : a_frame.atom_data) {
+    auto found = symbols.find(atm.atomic_number);
+    if (found == symbols.end()) {
+      throw std::invalid_argument(
+          "Invalid atomic number: " + std::to_string(atm.atomic_number));
+    }
+    result.atom_data.emplace_back(found->second, atm.x, atm.y, atm.z,
+                                  atm.is_fixed, atm.atom_id);
+  }
+  return result;
+}
+// Both precisions and every policy are compiled here, see the declarations in
+// ReadCon.hpp
+#define YODECON_INSTANTIATE_COORDINATES(REAL)                                  \
+  template void process_coordinates<REAL>(                                     \
+      const std::vector<std::string> &,                                        \
+      types::BasicConFrame<types::BasicAtomDatum<REAL>> &);                    \
+  template void process_coordinates<REAL>(const std::vector<std::string> &,    \
+                                          types::BasicConFrameVec<REAL> &);    \
+  template void process_coordinates<REAL>(                                     \
+      helpers::string::LineCursor &,                                           \
+      types::BasicConFrame<types::BasicAtomDatum<REAL>> &,                     \
+      const ParseOptions &);                                                   \
+  template void process_coordinates<REAL>(helpers::string::LineCursor &,       \
+                                          types::BasicConFrameVec<REAL> &,     \
+                                          const ParseOptions &);
+
+#define YODECON_INSTANTIATE_POLICY(POLICY)                                     \
+  template void process_coordinates<POLICY>(helpers::string::LineCursor &,     \
+                                            types::ConFrame &);                \
+  template void process_coordinates<POLICY>(helpers::string::LineCursor &,     \
+                                            types::ConFrameFloat &);           \
+  template void process_coordinates<POLICY>(helpers::string::LineCursor &,     \
+                                            types::ConFrameVec &);             \
+  template void process_coordinates<POLICY>(helpers::string::LineCursor &,     \
+                                            types::ConFrameVecFloat &);        \
+  template void process_coordinates<POLICY>(helpers::string::LineCursor &,     \
+                                            types::ConFrameVecTyped &);        \
+  template void process_coordinates<POLICY>(helpers::string::LineCursor &,     \
+                                            types::ConFrameCompact &);
+
+YODECON_INSTANTIATE_COORDINATES(double)
+YODECON_INSTANTIATE_COORDINATES(float)
+YODECON_INSTANTIATE_POLICY(policy::Lenient)
+YODECON_INSTANTIATE_POLICY(policy::Strict)
+YODECON_INSTANTIATE_POLICY(policy::Trusted)
+#undef YODECON_INSTANTIATE_COORDINATES
+#undef YODECON_INSTANTIATE_POLICY
 } // namespace yodecon
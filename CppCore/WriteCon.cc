@@ -0,0 +1,332 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <string_view>
+
+#include "readCon/include/WriteCon.hpp"
+
+namespace yodecon {
+namespace {
+// Longest `%.17f` of a double, DBL_MAX has 309 integral digits
+constexpr size_t MaxFixedChars{309 + 1 + 17 + 1};
+// An atom line, three coordinates and two integers with their separators
+constexpr size_t MaxAtomLineChars{3 * MaxFixedChars + 32};
+constexpr int CoordPrecision{17};
+constexpr size_t CoordWidth{22};
+constexpr size_t AtomIdWidth{4};
+constexpr int BoxPrecision{6};
+// `%22.17f` coordinates of moderate magnitude, used to size the buffer
+constexpr size_t TypicalAtomLineChars{3 * (CoordWidth + 1) + AtomIdWidth + 3};
+
+// Writes `a_val` like printf("%*.*f"), returning the end of the text.
+// `a_pos` needs room for MaxFixedChars.
+char *put_fixed(char *a_pos, double a_val, int a_precision, size_t a_width) {
+  auto [end, ec] = std::to_chars(a_pos, a_pos + MaxFixedChars, a_val,
+                                 std::chars_format::fixed, a_precision);
+  const size_t len = static_cast<size_t>(end - a_pos);
+  if (len >= a_width) {
+    return end;
+  }
+  const size_t fill = a_width - len;
+  std::memmove(a_pos + fill, a_pos, len);
+  std::memset(a_pos, ' ', fill);
+  return a_pos + a_width;
+}
+
+// Writes `a_val` like printf("%*d"), returning the end of the text
+template <typename Int>
+char *put_int(char *a_pos, Int a_val, size_t a_width = 0) {
+  char digits[24];
+  auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), a_val);
+  const size_t len = static_cast<size_t>(end - digits);
+  if (len < a_width) {
+    std::memset(a_pos, ' ', a_width - len);
+    a_pos += a_width - len;
+  }
+  std::memcpy(a_pos, digits, len);
+  return a_pos + len;
+}
+
+void append_line(std::string &a_out, const std::string &a_line) {
+  a_out += a_line;
+  a_out += '\n';
+}
+
+void append_fixed_row(std::string &a_out, const std::array<double, 3> &a_vals,
+                      char a_sep) {
+  char line[3 * MaxFixedChars + 4];
+  char *pos = line;
+  for (size_t idx{0}; idx < a_vals.size(); idx++) {
+    pos = put_fixed(pos, a_vals[idx], BoxPrecision, 0);
+    *pos++ = (idx + 1 < a_vals.size()) ? a_sep : '\n';
+  }
+  a_out.append(line, static_cast<size_t>(pos - line));
+}
+
+// The 9 header lines, shared by every frame type
+template <typename ConFrameLike>
+void format_header(const ConFrameLike &a_frame, std::string &a_out) {
+  append_line(a_out, a_frame.prebox_header[0]);
+  append_line(a_out, a_frame.prebox_header[1]);
+  append_fixed_row(a_out, a_frame.boxl, '\t');
+  append_fixed_row(a_out, a_frame.angles, '\t');
+  append_line(a_out, a_frame.postbox_header[0]);
+  append_line(a_out, a_frame.postbox_header[1]);
+  char field[MaxFixedChars + 1];
+  a_out.append(field, static_cast<size_t>(
+                          put_int(field, a_frame.natm_types) - field));
+  a_out += '\n';
+  for (size_t idx{0}; idx < a_frame.natm_types; idx++) {
+    char *end = put_int(field, a_frame.natms_per_type[idx]);
+    *end++ = (idx + 1 < a_frame.natm_types) ? ' ' : '\n';
+    a_out.append(field, static_cast<size_t>(end - field));
+  }
+  for (size_t idx{0}; idx < a_frame.natm_types; idx++) {
+    char *end =
+        put_fixed(field, a_frame.masses_per_type[idx], BoxPrecision, 0);
+    *end++ = (idx + 1 < a_frame.natm_types) ? ' ' : '\n';
+    a_out.append(field, static_cast<size_t>(end - field));
+  }
+}
+
+void format_component_header(std::string_view a_symbol, size_t a_component,
+                             std::string &a_out) {
+  a_out.append(a_symbol);
+  a_out += "\nCoordinates of Component ";
+  char digits[24];
+  a_out.append(digits,
+               static_cast<size_t>(put_int(digits, a_component + 1) - digits));
+  a_out += '\n';
+}
+
+char *put_atom_line(char *a_pos, double a_x, double a_y, double a_z,
+                    bool a_fixed, int a_atom_id) {
+  a_pos = put_fixed(a_pos, a_x, CoordPrecision, CoordWidth);
+  *a_pos++ = ' ';
+  a_pos = put_fixed(a_pos, a_y, CoordPrecision, CoordWidth);
+  *a_pos++ = ' ';
+  a_pos = put_fixed(a_pos, a_z, CoordPrecision, CoordWidth);
+  *a_pos++ = ' ';
+  *a_pos++ = a_fixed ? '1' : '0';
+  *a_pos++ = ' ';
+  a_pos = put_int(a_pos, a_atom_id, AtomIdWidth);
+  *a_pos++ = '\n';
+  return a_pos;
+}
+
+template <typename AtomT>
+const std::string &symbol_of(const types::BasicConFrame<AtomT> &a_frame,
+                             size_t a_idx) {
+  return a_frame.atom_data[a_idx].symbol;
+}
+
+template <typename Real>
+const std::string &symbol_of(const types::BasicConFrameVec<Real> &a_frame,
+                             size_t a_idx) {
+  return a_frame.symbol[a_idx];
+}
+
+template <typename ConFrameLike>
+void check_shape(const ConFrameLike &a_frame, size_t a_natoms) {
+  if (a_frame.natms_per_type.size() != a_frame.natm_types ||
+      a_frame.masses_per_type.size() != a_frame.natm_types) {
+    throw std::invalid_argument(
+        "natms_per_type and masses_per_type need an entry per component");
+  }
+  if (std::accumulate(a_frame.natms_per_type.begin(),
+                      a_frame.natms_per_type.end(),
+                      size_t{0}) != a_natoms) {
+    throw std::invalid_argument("natms_per_type does not add up to the atoms");
+  }
+  // Each component is written under the symbol of its first atom
+  size_t first{0};
+  for (size_t natms : a_frame.natms_per_type) {
+    for (size_t idx{first + 1}; idx < first + natms; idx++) {
+      if (symbol_of(a_frame, idx) != symbol_of(a_frame, first)) {
+        throw std::invalid_argument(
+            "Atoms of a component must share one symbol");
+      }
+    }
+    first += natms;
+  }
+}
+
+// Validates the frame, returning its number of atoms
+template <typename AtomT>
+size_t check_frame(const types::BasicConFrame<AtomT> &a_frame) {
+  check_shape(a_frame, a_frame.atom_data.size());
+  return a_frame.atom_data.size();
+}
+
+template <typename Real>
+size_t check_frame(const types::BasicConFrameVec<Real> &a_frame) {
+  const size_t natoms = a_frame.x.size();
+  if (a_frame.y.size() != natoms || a_frame.z.size() != natoms ||
+      a_frame.is_fixed.size() != natoms || a_frame.atom_id.size() != natoms ||
+      a_frame.symbol.size() != natoms) {
+    throw std::invalid_argument("Columns of the frame differ in length");
+  }
+  check_shape(a_frame, natoms);
+  return natoms;
+}
+
+// The atom lines of atoms [a_begin, a_end)
+template <typename AtomT>
+void format_atoms(const types::BasicConFrame<AtomT> &a_frame, size_t a_begin,
+                  size_t a_end, std::string &a_out) {
+  char line[MaxAtomLineChars];
+  for (size_t idx{a_begin}; idx < a_end; idx++) {
+    const auto &atm = a_frame.atom_data[idx];
+    const char *end =
+        put_atom_line(line, atm.x, atm.y, atm.z, atm.is_fixed, atm.atom_id);
+    a_out.append(line, static_cast<size_t>(end - line));
+  }
+}
+
+template <typename Real>
+void format_atoms(const types::BasicConFrameVec<Real> &a_frame, size_t a_begin,
+                  size_t a_end, std::string &a_out) {
+  char line[MaxAtomLineChars];
+  for (size_t idx{a_begin}; idx < a_end; idx++) {
+    const char *end =
+        put_atom_line(line, a_frame.x[idx], a_frame.y[idx], a_frame.z[idx],
+                      a_frame.is_fixed[idx], a_frame.atom_id[idx]);
+    a_out.append(line, static_cast<size_t>(end - line));
+  }
+}
+
+/**
+ * A contiguous part of the atom lines of one component, preceded by the
+ * component header when it is the first. The text of a frame is its header
+ * followed by the text of its pieces in order, however the atoms are split.
+ */
+struct Piece {
+  size_t component;
+  size_t begin;
+  size_t end;
+  bool first;
+};
+
+template <typename ConFrameLike>
+void format_piece(const ConFrameLike &a_frame, const Piece &a_piece,
+                  std::string &a_out) {
+  if (a_piece.first) {
+    format_component_header(a_piece.begin < a_piece.end
+                                ? std::string_view{symbol_of(a_frame,
+                                                             a_piece.begin)}
+                                : std::string_view{},
+                            a_piece.component, a_out);
+  }
+  format_atoms(a_frame, a_piece.begin, a_piece.end, a_out);
+}
+
+// Splits every component into pieces of at most `a_atoms_per_piece` atoms
+template <typename ConFrameLike>
+std::vector<Piece> split_atoms(const ConFrameLike &a_frame,
+                               size_t a_atoms_per_piece) {
+  std::vector<Piece> pieces;
+  size_t first{0};
+  for (size_t comp{0}; comp < a_frame.natm_types; comp++) {
+    const size_t last = first + a_frame.natms_per_type[comp];
+    size_t begin{first};
+    do {
+      const size_t end = std::min(last, begin + a_atoms_per_piece);
+      pieces.push_back(Piece{comp, begin, end, begin == first});
+      begin = end;
+    } while (begin < last);
+    first = last;
+  }
+  return pieces;
+}
+} // namespace
+
+template <typename ConFrameLike>
+void format_con(const ConFrameLike &a_frame, std::string &a_out) {
+  const size_t natoms = check_frame(a_frame);
+  a_out.reserve(a_out.size() + natoms * TypicalAtomLineChars);
+  format_header(a_frame, a_out);
+  for (const auto &piece : split_atoms(a_frame, std::max<size_t>(natoms, 1))) {
+    format_piece(a_frame, piece, a_out);
+  }
+}
+
+template <typename ConFrameLike>
+void format_con(const ConFrameLike &a_frame, std::string &a_out,
+                helpers::parallel::ThreadPool &a_pool,
+                size_t a_atoms_per_task) {
+  const size_t natoms = check_frame(a_frame);
+  a_atoms_per_task = std::max<size_t>(a_atoms_per_task, 1);
+  if (a_pool.size() < 2 || natoms <= a_atoms_per_task) {
+    format_con(a_frame, a_out);
+    return;
+  }
+  const auto pieces = split_atoms(a_frame, a_atoms_per_task);
+  std::vector<std::string> texts(pieces.size());
+  a_pool.parallel_for(pieces.size(), [&](size_t a_idx) {
+    const auto &piece = pieces[a_idx];
+    texts[a_idx].reserve((piece.end - piece.begin) * TypicalAtomLineChars);
+    format_piece(a_frame, piece, texts[a_idx]);
+  });
+  size_t nbytes{0};
+  for (const auto &text : texts) {
+    nbytes += text.size();
+  }
+  format_header(a_frame, a_out);
+  a_out.reserve(a_out.size() + nbytes);
+  for (const auto &text : texts) {
+    a_out += text;
+  }
+}
+
+ConWriter::ConWriter(const std::string &a_fname, size_t a_chunk_bytes)
+    : m_owned{std::make_unique<std::ofstream>(
+          a_fname, std::ios::binary | std::ios::trunc)},
+      m_stream{m_owned.get()}, m_chunk_bytes{a_chunk_bytes} {
+  if (!m_owned->is_open()) {
+    throw std::runtime_error("Failed to open the file");
+  }
+  m_buffer.reserve(m_chunk_bytes);
+}
+
+ConWriter::ConWriter(std::ostream &a_stream, size_t a_chunk_bytes)
+    : m_stream{&a_stream}, m_chunk_bytes{a_chunk_bytes} {
+  m_buffer.reserve(m_chunk_bytes);
+}
+
+ConWriter::~ConWriter() {
+  try {
+    flush();
+  } catch (...) {
+    // Destructors must not throw, call flush() to see errors
+  }
+}
+
+void ConWriter::flush() {
+  if (!m_buffer.empty()) {
+    if (!m_stream->write(m_buffer.data(),
+                         static_cast<std::streamsize>(m_buffer.size()))) {
+      throw std::runtime_error("Failed to write the trajectory");
+    }
+    m_written += m_buffer.size();
+    m_buffer.clear();
+  }
+  if (!m_stream->flush()) {
+    throw std::runtime_error("Failed to write the trajectory");
+  }
+}
+
+#define YODECON_INSTANTIATE_FORMAT(FRAME)                                      \
+  template void format_con(const FRAME &, std::string &);                      \
+  template void format_con(const FRAME &, std::string &,                       \
+                           helpers::parallel::ThreadPool &, size_t);
+
+YODECON_INSTANTIATE_FORMAT(types::ConFrame)
+YODECON_INSTANTIATE_FORMAT(types::ConFrameFloat)
+YODECON_INSTANTIATE_FORMAT(types::ConFrameVec)
+YODECON_INSTANTIATE_FORMAT(types::ConFrameVecFloat)
+#undef YODECON_INSTANTIATE_FORMAT
+} // namespace yodecon
@@ -0,0 +1,71 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "readCon/include/ReadCon.hpp"
+
+#include "BenchHelpers.hpp"
+
+// GCC cannot tell that the replaced operator new below is malloc based
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+namespace {
+std::atomic<size_t> g_nallocs{0};
+
+// Number of heap allocations made while running `a_fn`
+template <typename Func> size_t count_allocations(Func &&a_fn) {
+  const size_t before = g_nallocs.load();
+  a_fn();
+  return g_nallocs.load() - before;
+}
+} // namespace
+
+// Counts every allocation in the process, the parse path is the only thing
+// running while the counter is read
+void *operator new(std::size_t a_size) {
+  g_nallocs.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(a_size == 0 ? 1 : a_size)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+void operator delete(void *a_ptr) noexcept { std::free(a_ptr); }
+void operator delete(void *a_ptr, std::size_t) noexcept { std::free(a_ptr); }
+
+int main() {
+  bool constant{true};
+  size_t first_vec{0};
+  size_t first_frame{0};
+  std::printf("%-12s %-22s %-22s\n", "natoms", "allocs (ConFrameVec)",
+              "allocs (ConFrame)");
+  for (size_t natoms : {10, 100, 1000, 10000, 100000}) {
+    const std::string text =
+        yodecon::bench::make_con_text(1, {natoms / 2, natoms - natoms / 2});
+    double sink{0};
+    const size_t nvec = count_allocations([&] {
+      auto res = yodecon::create_single_con<yodecon::types::ConFrameVec>(text);
+      sink += res.x[0];
+    });
+    const size_t nframe = count_allocations([&] {
+      auto res = yodecon::create_single_con<yodecon::types::ConFrame>(text);
+      sink += res.atom_data[0].x;
+    });
+    std::printf("%-12zu %-22zu %-22zu\n", natoms, nvec, nframe);
+    if (first_vec == 0) {
+      first_vec = nvec;
+      first_frame = nframe;
+    }
+    constant = constant && nvec == first_vec && nframe == first_frame &&
+               sink != 0;
+  }
+  std::printf("allocations per frame independent of atom count: %s\n",
+              constant ? "yes" : "no");
+  return constant ? 0 : 1;
+}
@@ -0,0 +1,52 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "readCon/include/ConArrow.hpp"
+#include "readCon/include/ReadCon.hpp"
+
+#include "BenchHelpers.hpp"
+
+int main() {
+  constexpr size_t nframes{200};
+  const std::string text = yodecon::bench::make_con_text(nframes, {2000, 500});
+  const double natoms = static_cast<double>(nframes * 2500);
+  const std::string fname =
+      (std::filesystem::temp_directory_path() / "readcon_bench.arrow").string();
+
+  auto to_arrow = [&] {
+    return yodecon::conarrow::ConvertTrajectoryToArrow(
+        yodecon::create_multi_con<yodecon::types::ConFrameVec>(text), 1);
+  };
+  yodecon::conarrow::write_ipc(fname, *to_arrow().atoms);
+
+  double sink{0};
+  auto parse = yodecon::bench::time_best_of(3, [&] {
+    sink += yodecon::create_multi_con<yodecon::types::ConFrameVec>(text)
+                .back()
+                .x[0];
+  });
+  auto convert = yodecon::bench::time_best_of(
+      3, [&] { sink += to_arrow().cells->num_rows(); });
+  // Touches every coordinate, straight from the mapping
+  auto reload = yodecon::bench::time_best_of(3, [&] {
+    auto table = yodecon::conarrow::read_ipc(fname);
+    for (const auto &chunk : table->GetColumnByName("x")->chunks()) {
+      for (auto val : *std::static_pointer_cast<arrow::DoubleArray>(chunk)) {
+        sink += *val;
+      }
+    }
+  });
+
+  yodecon::bench::report("create_multi_con<ConFrameVec> from text", natoms,
+                         "atoms", parse);
+  yodecon::bench::report("text to ConvertTrajectoryToArrow", natoms, "atoms",
+                         convert);
+  yodecon::bench::report("read_ipc, summing x", natoms, "atoms", reload);
+  std::printf("read_ipc vs text parse: %.1fx\n", parse / reload);
+  std::filesystem::remove(fname);
+  return sink == 0 ? 1 : 0;
+}
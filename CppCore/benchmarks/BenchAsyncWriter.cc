@@ -0,0 +1,73 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "readCon/include/AsyncConWriter.hpp"
+#include "readCon/include/ReadCon.hpp"
+
+#include "BenchHelpers.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double seconds_since(Clock::time_point a_start) {
+  return std::chrono::duration<double>(Clock::now() - a_start).count();
+}
+} // namespace
+
+int main() {
+  constexpr size_t nframes{100};
+  const std::string text = yodecon::bench::make_con_text(nframes, {8000, 2000});
+  const auto frames =
+      yodecon::create_multi_con<yodecon::types::ConFrameVec>(text);
+  const std::string fname =
+      (std::filesystem::temp_directory_path() / "readcon_bench_async.con")
+          .string();
+
+  // Time spent in the caller, per frame, and until the file is complete
+  double sync_caller{0};
+  double sync_total = yodecon::bench::time_best_of(3, [&] {
+    yodecon::ConWriter out{fname};
+    auto start = Clock::now();
+    for (const auto &frame : frames) {
+      out.write(frame);
+    }
+    sync_caller = seconds_since(start);
+    out.flush();
+  });
+  double async_caller{0};
+  double async_total{0};
+  for (size_t rep{0}; rep < 3; rep++) {
+    auto copies = frames;
+    auto total_start = Clock::now();
+    yodecon::AsyncConWriter<yodecon::types::ConFrameVec> out{fname, nframes};
+    auto start = Clock::now();
+    for (auto &frame : copies) {
+      out.write(std::move(frame));
+    }
+    const double caller = seconds_since(start);
+    out.close();
+    const double total = seconds_since(total_start);
+    if (rep == 0 || total < async_total) {
+      async_caller = caller;
+      async_total = total;
+    }
+  }
+
+  std::printf("%-44s %10.2f us/frame\n", "ConWriter::write, caller",
+              sync_caller / nframes * 1e6);
+  std::printf("%-44s %10.2f us/frame\n", "AsyncConWriter::write, caller",
+              async_caller / nframes * 1e6);
+  const double nbytes = static_cast<double>(text.size());
+  yodecon::bench::report("ConWriter, until flushed", nbytes, "B", sync_total);
+  yodecon::bench::report("AsyncConWriter, until closed", nbytes, "B",
+                         async_total);
+  std::printf("caller latency, sync vs async: %.0fx\n",
+              sync_caller / async_caller);
+  std::filesystem::remove(fname);
+  return 0;
+}
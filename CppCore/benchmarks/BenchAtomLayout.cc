@@ -0,0 +1,57 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <array>
+#include <cstdio>
+#include <string>
+
+#include "readCon/include/ReadCon.hpp"
+
+#include "BenchHelpers.hpp"
+
+namespace {
+// A typical full frame sweep, the centroid of the mobile atoms
+template <typename ConFrameLike>
+std::array<double, 3> mobile_centroid(const ConFrameLike &a_frame) {
+  std::array<double, 3> sum{};
+  size_t nmobile{0};
+  for (const auto &atm : a_frame.atom_data) {
+    if (!atm.is_fixed) {
+      sum[0] += atm.x;
+      sum[1] += atm.y;
+      sum[2] += atm.z;
+      nmobile++;
+    }
+  }
+  for (auto &val : sum) {
+    val /= static_cast<double>(nmobile);
+  }
+  return sum;
+}
+} // namespace
+
+int main() {
+  constexpr size_t natoms{2000000};
+  const std::string text =
+      yodecon::bench::make_con_text(1, {natoms / 2, natoms / 2});
+  const auto frame = yodecon::create_single_con<yodecon::types::ConFrame>(text);
+  const auto compact = yodecon::to_compact(frame);
+
+  double sink{0};
+  auto aos = yodecon::bench::time_best_of(
+      20, [&] { sink += mobile_centroid(frame)[0]; });
+  auto packed = yodecon::bench::time_best_of(
+      20, [&] { sink += mobile_centroid(compact)[0]; });
+
+  constexpr size_t atom_bytes{sizeof(yodecon::types::AtomDatum)};
+  constexpr size_t compact_bytes{sizeof(yodecon::types::AtomDatumCompact)};
+  yodecon::bench::report("AtomDatum sweep (" + std::to_string(atom_bytes) +
+                             " B/atom)",
+                         natoms * atom_bytes, "B", aos);
+  yodecon::bench::report("AtomDatumCompact sweep (" +
+                             std::to_string(compact_bytes) + " B/atom)",
+                         natoms * compact_bytes, "B", packed);
+  yodecon::bench::report("AtomDatum sweep", natoms, "atoms", aos);
+  yodecon::bench::report("AtomDatumCompact sweep", natoms, "atoms", packed);
+  std::printf("speedup (atoms/s): %.2fx\n", aos / packed);
+  return sink == 0 ? 1 : 0;
+}
@@ -0,0 +1,54 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "readCon/include/ConBinary.hpp"
+#include "readCon/include/ReadCon.hpp"
+
+#include "BenchHelpers.hpp"
+
+int main() {
+  constexpr size_t nframes{200};
+  const std::string text = yodecon::bench::make_con_text(nframes, {2000, 500});
+  const double natoms = static_cast<double>(nframes * 2500);
+  const std::string fname =
+      (std::filesystem::temp_directory_path() / "readcon_bench.conb").string();
+
+  auto frames = yodecon::create_multi_con<yodecon::types::ConFrameVec>(text);
+  yodecon::conb::write_conb(fname, frames);
+
+  double sink{0};
+  auto parse = yodecon::bench::time_best_of(3, [&] {
+    sink += yodecon::create_multi_con<yodecon::types::ConFrameVec>(text)
+                .back()
+                .x[0];
+  });
+  auto write = yodecon::bench::time_best_of(
+      3, [&] { yodecon::conb::write_conb(fname, frames); });
+  auto copy = yodecon::bench::time_best_of(3, [&] {
+    yodecon::conb::ConbReader traj{fname};
+    sink += traj.read_all().back().x[0];
+  });
+  // Touches every coordinate, straight from the mapping
+  auto view = yodecon::bench::time_best_of(3, [&] {
+    yodecon::conb::ConbReader traj{fname};
+    for (size_t idx{0}; idx < traj.size(); idx++) {
+      for (double val : traj.frame(idx).x()) {
+        sink += val;
+      }
+    }
+  });
+
+  yodecon::bench::report("create_multi_con<ConFrameVec> from text", natoms,
+                         "atoms", parse);
+  yodecon::bench::report("write_conb", natoms, "atoms", write);
+  yodecon::bench::report("ConbReader::read_all", natoms, "atoms", copy);
+  yodecon::bench::report("ConbReader::frame views, summing x", natoms,
+                         "atoms", view);
+  std::printf("read_all vs text parse: %.1fx\n", parse / copy);
+  std::filesystem::remove(fname);
+  return sink == 0 ? 1 : 0;
+}
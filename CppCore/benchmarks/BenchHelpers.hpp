@@ -0,0 +1,83 @@
+#pragma once
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+// clang-format off
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+// clang-format on
+
+namespace yodecon::bench {
+/**
+ * @brief Wall time of the fastest of `a_reps` runs of `a_fn`, in seconds.
+ *
+ * Best-of timing keeps the numbers stable on shared machines, the benchmarks
+ * here compare implementations rather than measure absolute latency.
+ */
+template <typename Func> double time_best_of(size_t a_reps, Func &&a_fn) {
+  double best{std::numeric_limits<double>::max()};
+  for (size_t rep{0}; rep < a_reps; rep++) {
+    auto start = std::chrono::steady_clock::now();
+    a_fn();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    best = std::min(best, elapsed.count());
+  }
+  return best;
+}
+
+//! Prints a throughput line, e.g. "scanner   12.3 Matoms/s"
+inline void report(const std::string &a_name, double a_units,
+                   const std::string &a_unit, double a_seconds) {
+  std::printf("%-44s %10.3f M%s/s (%.4f s)\n", a_name.c_str(),
+              a_units / a_seconds / 1e6, a_unit.c_str(), a_seconds);
+}
+
+/**
+ * @brief Generates an eON style trajectory with `a_nframes` frames.
+ *
+ * Every frame has the same composition, one component per entry of
+ * `a_natms_per_type`, with coordinates printed at full precision like eON does.
+ */
+inline std::string make_con_text(size_t a_nframes,
+                                 const std::vector<size_t> &a_natms_per_type,
+                                 unsigned a_seed = 42) {
+  const std::vector<std::string> symbols{"Cu", "H", "O", "C", "N", "S"};
+  const std::vector<std::string> masses{"63.546000", "1.007930", "15.999000",
+                                        "12.011000", "14.007000", "32.065000"};
+  std::mt19937 gen{a_seed};
+  std::uniform_real_distribution<double> coord{0.0, 25.0};
+  std::string out;
+  char buf[160];
+  for (size_t frm{0}; frm < a_nframes; frm++) {
+    out += "Random Number Seed\nTime\n";
+    out += "25.000000\t25.000000\t25.000000\n";
+    out += "90.000000\t90.000000\t90.000000\n0 0\n0 0 0\n";
+    out += std::to_string(a_natms_per_type.size()) + "\n";
+    for (size_t idx{0}; idx < a_natms_per_type.size(); idx++) {
+      out += std::to_string(a_natms_per_type[idx]);
+      out += (idx + 1 < a_natms_per_type.size()) ? " " : "\n";
+    }
+    for (size_t idx{0}; idx < a_natms_per_type.size(); idx++) {
+      out += masses[idx % masses.size()];
+      out += (idx + 1 < a_natms_per_type.size()) ? " " : "\n";
+    }
+    size_t atom_id{0};
+    for (size_t idx{0}; idx < a_natms_per_type.size(); idx++) {
+      out += symbols[idx % symbols.size()] + "\n";
+      out += "Coordinates of Component " + std::to_string(idx + 1) + "\n";
+      for (size_t atm{0}; atm < a_natms_per_type[idx]; atm++) {
+        std::snprintf(buf, sizeof(buf), "%22.17f %22.17f %22.17f %d %5zu\n",
+                      coord(gen), coord(gen), coord(gen),
+                      static_cast<int>(idx == 0), atom_id++);
+        out += buf;
+      }
+    }
+  }
+  return out;
+}
+} // namespace yodecon::bench
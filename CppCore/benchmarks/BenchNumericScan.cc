@@ -0,0 +1,96 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <array>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "readCon/include/ReadCon.hpp"
+
+#include "BenchHelpers.hpp"
+
+namespace {
+// The pre from_chars chain: regex per token, split into strings, one
+// istringstream per token
+std::array<double, 5> legacy_get_array(const std::string &a_line) {
+  std::array<double, 5> retval{};
+  size_t idx{0};
+  auto elements = yodecon::helpers::string::get_split_strings(a_line);
+  for (const auto &elem : elements) {
+    const std::regex number_regex{
+        "((\\+|-)?[[:digit:]]+)(\\.(([[:digit:]]+)?))?"};
+    if (!std::regex_match(elem, number_regex)) {
+      continue;
+    }
+    std::istringstream ss{elem};
+    ss >> retval[idx++];
+  }
+  return retval;
+}
+} // namespace
+
+int main() {
+  constexpr size_t natoms{100000};
+  const std::string text =
+      yodecon::bench::make_con_text(1, {natoms / 2, natoms / 2});
+  // Only the atom lines, skipping the header and component headers
+  std::vector<std::string> atom_lines;
+  yodecon::helpers::string::LineCursor cursor{text};
+  std::string_view line;
+  while (cursor.next(line)) {
+    if (line.size() > 60) {
+      atom_lines.emplace_back(line);
+    }
+  }
+
+  double sink{0};
+  // The legacy chain is orders of magnitude slower, time a slice of the lines
+  constexpr size_t nlegacy{2000};
+  auto legacy = yodecon::bench::time_best_of(1, [&] {
+    for (size_t idx{0}; idx < nlegacy; idx++) {
+      sink += legacy_get_array(atom_lines[idx])[0];
+    }
+  });
+  auto scanner = yodecon::bench::time_best_of(10, [&] {
+    std::array<double, 5> vals{};
+    for (const auto &line : atom_lines) {
+      yodecon::helpers::string::scan_numbers(line, vals);
+      sink += vals[0];
+    }
+  });
+  auto frame = yodecon::bench::time_best_of(10, [&] {
+    auto res = yodecon::create_single_con<yodecon::types::ConFrameVec>(text);
+    sink += res.x[0];
+  });
+  auto strict = yodecon::bench::time_best_of(10, [&] {
+    auto res = yodecon::create_single_con<yodecon::types::ConFrameVec,
+                                          yodecon::policy::Strict>(text);
+    sink += res.x[0];
+  });
+  auto trusted = yodecon::bench::time_best_of(10, [&] {
+    auto res = yodecon::create_single_con<yodecon::types::ConFrameVec,
+                                          yodecon::policy::Trusted>(text);
+    sink += res.x[0];
+  });
+  yodecon::ParseOptions positions;
+  positions.columns = yodecon::columns::Positions;
+  auto positions_only = yodecon::bench::time_best_of(10, [&] {
+    auto res = yodecon::create_single_con<yodecon::types::ConFrameVec>(
+        text, positions);
+    sink += res.x[0];
+  });
+
+  yodecon::bench::report("regex + istringstream per token", nlegacy, "atoms",
+                         legacy);
+  yodecon::bench::report("from_chars scan_numbers", natoms, "atoms", scanner);
+  yodecon::bench::report("create_single_con<ConFrameVec>(string_view)", natoms,
+                         "atoms", frame);
+  yodecon::bench::report("  policy::Strict", natoms, "atoms", strict);
+  yodecon::bench::report("  policy::Trusted", natoms, "atoms", trusted);
+  yodecon::bench::report("  columns::Positions only", natoms, "atoms",
+                         positions_only);
+  std::printf("speedup (line conversion): %.1fx\n",
+              (legacy / nlegacy) / (scanner / natoms));
+  return sink == 0 ? 1 : 0;
+}
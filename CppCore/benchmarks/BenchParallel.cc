@@ -0,0 +1,44 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "readCon/include/ConIndex.hpp"
+
+#include "BenchHelpers.hpp"
+
+int main() {
+  constexpr size_t nframes{200};
+  const std::vector<size_t> composition{2000, 500};
+  const std::string text =
+      yodecon::bench::make_con_text(nframes, composition);
+  const double natoms = nframes * 2500.0;
+
+  size_t sink{0};
+  auto sequential = yodecon::bench::time_best_of(3, [&] {
+    sink += yodecon::create_multi_con<yodecon::types::ConFrameVec>(text).size();
+  });
+  yodecon::bench::report("create_multi_con", natoms, "atoms", sequential);
+
+  auto index_only = yodecon::bench::time_best_of(
+      5, [&] { sink += yodecon::ConIndex{text}.size(); });
+  yodecon::bench::report("ConIndex boundary scan", natoms, "atoms",
+                         index_only);
+
+  const size_t maxthreads =
+      std::max(1U, std::thread::hardware_concurrency());
+  for (size_t nthreads{1}; nthreads <= maxthreads; nthreads *= 2) {
+    const yodecon::ConIndex index{text};
+    yodecon::helpers::parallel::ThreadPool pool{nthreads};
+    auto parallel = yodecon::bench::time_best_of(3, [&] {
+      sink +=
+          yodecon::read_frames<yodecon::types::ConFrameVec>(index, pool).size();
+    });
+    yodecon::bench::report("read_frames, " + std::to_string(nthreads) +
+                               " threads",
+                           natoms, "atoms", parallel);
+    std::printf("  speedup over sequential: %.2fx\n", sequential / parallel);
+  }
+  return sink == 0 ? 1 : 0;
+}
@@ -0,0 +1,50 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "readCon/include/ConIndex.hpp"
+#include "readCon/include/ConSummary.hpp"
+#include "readCon/include/ReadCon.hpp"
+
+#include "BenchHelpers.hpp"
+
+int main() {
+  constexpr size_t nframes{400};
+  const std::string text = yodecon::bench::make_con_text(nframes, {2000, 500});
+  const double nbytes = static_cast<double>(text.size());
+
+  size_t sink{0};
+  // The floor for any line based scan, one memchr pass over the buffer
+  auto newlines = yodecon::bench::time_best_of(5, [&] {
+    const char *pos = text.data();
+    const char *end = text.data() + text.size();
+    while ((pos = static_cast<const char *>(
+                std::memchr(pos, '\n', static_cast<size_t>(end - pos))))) {
+      ++pos;
+      ++sink;
+    }
+  });
+  auto summary = yodecon::bench::time_best_of(
+      5, [&] { sink += yodecon::scan_con(text).total_atoms(); });
+  auto parse = yodecon::bench::time_best_of(1, [&] {
+    sink += yodecon::create_multi_con<yodecon::types::ConFrameVec>(text).size();
+  });
+  auto every_100th = yodecon::bench::time_best_of(5, [&] {
+    sink += yodecon::create_multi_con_slice<yodecon::types::ConFrameVec>(
+                text, yodecon::FrameSlice{0, yodecon::FrameSlice::End, 100})
+                .size();
+  });
+
+  yodecon::bench::report("memchr newline count", nbytes, "B", newlines);
+  yodecon::bench::report("scan_con header summary", nbytes, "B", summary);
+  yodecon::bench::report("create_multi_con<ConFrameVec>", nbytes, "B", parse);
+  yodecon::bench::report("create_multi_con_slice, every 100th frame",
+                         nbytes, "B", every_100th);
+  std::printf("scan_con vs full parse: %.1fx\n", parse / summary);
+  std::printf("every 100th frame vs full parse: %.1fx\n",
+              parse / every_100th);
+  return sink == 0 ? 1 : 0;
+}
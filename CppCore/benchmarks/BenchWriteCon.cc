@@ -0,0 +1,85 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "readCon/include/ReadCon.hpp"
+#include "readCon/include/WriteCon.hpp"
+
+#include "BenchHelpers.hpp"
+
+int main() {
+  constexpr size_t nframes{200};
+  const std::string text = yodecon::bench::make_con_text(nframes, {2000, 500});
+  const double nbytes = static_cast<double>(text.size());
+  const std::string fname =
+      (std::filesystem::temp_directory_path() / "readcon_bench_write.con")
+          .string();
+  const auto frames =
+      yodecon::create_multi_con<yodecon::types::ConFrameVec>(text);
+
+  size_t sink{0};
+  auto parse = yodecon::bench::time_best_of(3, [&] {
+    sink += yodecon::create_multi_con<yodecon::types::ConFrameVec>(text)
+                .size();
+  });
+  // What a printf based writer costs, for the atom lines alone
+  auto snprintf_lines = yodecon::bench::time_best_of(3, [&] {
+    std::string out;
+    char line[160];
+    for (const auto &frame : frames) {
+      for (size_t idx{0}; idx < frame.x.size(); idx++) {
+        int len = std::snprintf(
+            line, sizeof(line), "%22.17f %22.17f %22.17f %d %4d\n",
+            frame.x[idx], frame.y[idx], frame.z[idx],
+            static_cast<int>(frame.is_fixed[idx]), frame.atom_id[idx]);
+        out.append(line, static_cast<size_t>(len));
+      }
+    }
+    sink += out.size();
+  });
+  std::string buffer;
+  auto format = yodecon::bench::time_best_of(3, [&] {
+    buffer.clear();
+    for (const auto &frame : frames) {
+      yodecon::format_con(frame, buffer);
+    }
+    sink += buffer.size();
+  });
+  auto write = yodecon::bench::time_best_of(
+      3, [&] { yodecon::write_multi_con(fname, frames); });
+
+  yodecon::bench::report("create_multi_con<ConFrameVec>", nbytes, "B", parse);
+  yodecon::bench::report("snprintf atom lines", nbytes, "B", snprintf_lines);
+  yodecon::bench::report("format_con into a reused buffer", nbytes, "B",
+                         format);
+  yodecon::bench::report("write_multi_con to a file", nbytes, "B", write);
+  std::printf("format_con vs snprintf: %.1fx\n", snprintf_lines / format);
+
+  // One million atom frame, split across threads
+  const auto big = yodecon::create_single_con<yodecon::types::ConFrameVec>(
+      yodecon::bench::make_con_text(1, {800000, 200000}));
+  std::string serial;
+  auto big_serial = yodecon::bench::time_best_of(3, [&] {
+    serial.clear();
+    yodecon::format_con(big, serial);
+  });
+  yodecon::helpers::parallel::ThreadPool pool;
+  std::string parallel;
+  auto big_parallel = yodecon::bench::time_best_of(3, [&] {
+    parallel.clear();
+    yodecon::format_con(big, parallel, pool);
+  });
+  const double big_bytes = static_cast<double>(serial.size());
+  yodecon::bench::report("format_con, 1M atom frame", big_bytes, "B",
+                         big_serial);
+  yodecon::bench::report("format_con on " + std::to_string(pool.size()) +
+                             " threads, 1M atom frame",
+                         big_bytes, "B", big_parallel);
+  std::printf("parallel vs serial: %.1fx, identical: %s\n",
+              big_serial / big_parallel, serial == parallel ? "yes" : "no");
+  std::filesystem::remove(fname);
+  return sink == 0 ? 1 : 0;
+}
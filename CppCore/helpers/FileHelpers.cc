@@ -1,13 +1,33 @@
 // MIT License
 // Copyright 2023--present Rohit Goswami <HaoZeke>
-#include <iostream>
 #include <stdexcept>
 
+#include <atomic>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
-#include <sstream>
+#include <random>
+#include <string>
+#include <system_error>
+#include <utility>
 #include <vector>
 
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "readCon/include/Compression.hpp"
 #include "readCon/include/Helpers.hpp"
 
 namespace fs = std::filesystem;
@@ -15,27 +35,179 @@ namespace fs = std::filesystem;
 namespace yodecon::helpers {
 namespace file {
 std::vector<std::string> read_con_file(const std::string &a_fname) {
-  if (fs::exists(a_fname)) {
-    std::ifstream file{a_fname};
-    if (file.is_open()) {
-      auto size = fs::file_size(a_fname);
-      std::string content(size, '\0');
-      file.seekg(0);
-      file.read(&content[0], size);
-      file.close();
-      std::istringstream ss{content};
-      std::string line;
-      std::vector<std::string> lines;
-      while (std::getline(ss, line)) {
-        lines.push_back(line);
+  if (compression::detect_codec_of(a_fname) != compression::Codec::None) {
+    // Decoded a chunk at a time, only the lines themselves are kept
+    auto input = compression::open_input(a_fname);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(*input, line)) {
+      if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
       }
-      return lines;
-    } else {
-      throw std::runtime_error("Failed to open the file");
+      lines.push_back(std::move(line));
     }
-  } else {
+    return lines;
+  }
+  MappedFile mapped{a_fname};
+  string::LineCursor cursor{mapped.view()};
+  std::vector<std::string> lines;
+  std::string_view line;
+  while (cursor.next(line)) {
+    lines.emplace_back(line);
+  }
+  return lines;
+}
+
+MappedFile::MappedFile(const std::string &a_fname) {
+  if (!fs::exists(a_fname)) {
     throw std::runtime_error("File not found");
   }
+#ifdef _WIN32
+  HANDLE file =
+      CreateFileA(a_fname.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                  OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("Failed to open the file");
+  }
+  LARGE_INTEGER fsize;
+  if (!GetFileSizeEx(file, &fsize)) {
+    CloseHandle(file);
+    throw std::runtime_error("Failed to open the file");
+  }
+  m_size = static_cast<size_t>(fsize.QuadPart);
+  if (m_size > 0) {
+    HANDLE mapping =
+        CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+      CloseHandle(file);
+      throw std::runtime_error("Failed to map the file");
+    }
+    void *addr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (addr == nullptr) {
+      CloseHandle(mapping);
+      CloseHandle(file);
+      throw std::runtime_error("Failed to map the file");
+    }
+    m_mapping = mapping;
+    m_data = static_cast<const char *>(addr);
+  }
+  // The mapping keeps its own reference to the file
+  CloseHandle(file);
+#else
+  int fd = ::open(a_fname.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open the file");
+  }
+  struct stat st {};
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Failed to open the file");
+  }
+  m_size = static_cast<size_t>(st.st_size);
+  if (m_size > 0) {
+    void *addr = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("Failed to map the file");
+    }
+    // Frames are consumed front to back, let the kernel read ahead
+    ::madvise(addr, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const char *>(addr);
+  }
+  // The mapping stays valid after the descriptor is closed
+  ::close(fd);
+#endif
+}
+
+MappedFile::~MappedFile() { release(); }
+
+MappedFile::MappedFile(MappedFile &&a_other) noexcept
+    : m_data{std::exchange(a_other.m_data, nullptr)},
+      m_size{std::exchange(a_other.m_size, 0)}
+#ifdef _WIN32
+      ,
+      m_mapping{std::exchange(a_other.m_mapping, nullptr)}
+#endif
+{
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&a_other) noexcept {
+  if (this != &a_other) {
+    release();
+    m_data = std::exchange(a_other.m_data, nullptr);
+    m_size = std::exchange(a_other.m_size, 0);
+#ifdef _WIN32
+    m_mapping = std::exchange(a_other.m_mapping, nullptr);
+#endif
+  }
+  return *this;
+}
+
+void MappedFile::release() noexcept {
+  if (m_data == nullptr) {
+    return;
+  }
+#ifdef _WIN32
+  UnmapViewOfFile(m_data);
+  CloseHandle(m_mapping);
+  m_mapping = nullptr;
+#else
+  ::munmap(const_cast<char *>(m_data), m_size);
+#endif
+  m_data = nullptr;
+  m_size = 0;
+}
+
+std::optional<int64_t> file_mtime(const std::string &a_fname) {
+  std::error_code ec;
+  auto mtime = fs::last_write_time(a_fname, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  return static_cast<int64_t>(mtime.time_since_epoch().count());
+}
+
+namespace {
+// A name next to `a_fname` which no other writer, in this process or
+// another, picks at the same time
+std::string unique_tmpname(const std::string &a_fname) {
+  static std::atomic<uint64_t> counter{0};
+  static const uint64_t seed = [] {
+    std::random_device rd;
+    return (static_cast<uint64_t>(rd()) << 32) ^ rd() ^
+           static_cast<uint64_t>(
+               std::chrono::steady_clock::now().time_since_epoch().count());
+  }();
+#ifdef _WIN32
+  const auto pid = static_cast<uint64_t>(GetCurrentProcessId());
+#else
+  const auto pid = static_cast<uint64_t>(::getpid());
+#endif
+  return a_fname + ".tmp." + std::to_string(pid) + "." +
+         std::to_string(seed) + "." + std::to_string(counter++);
+}
+} // namespace
+
+bool write_atomically(const std::string &a_fname, std::string_view a_bytes) {
+  const std::string tmpname = unique_tmpname(a_fname);
+  std::error_code ec;
+  std::ofstream ofs{tmpname, std::ios::binary | std::ios::trunc};
+  if (!ofs.is_open()) {
+    return false;
+  }
+  ofs.write(a_bytes.data(), static_cast<std::streamsize>(a_bytes.size()));
+  // Closing flushes, a short write may only show up here
+  ofs.close();
+  if (!ofs) {
+    fs::remove(tmpname, ec);
+    return false;
+  }
+  fs::rename(tmpname, a_fname, ec);
+  if (ec) {
+    fs::remove(tmpname, ec);
+    return false;
+  }
+  return true;
 }
 } // namespace file
 } // namespace yodecon::helpers
@@ -8,8 +8,10 @@
 namespace yodecon::helpers {
 namespace string {
 bool isNumber(const std::string &a_token) {
-  return std::regex_match(
-      a_token, std::regex(("((\\+|-)?[[:digit:]]+)(\\.(([[:digit:]]+)?))?")));
+  // Compiled once, building a std::regex is far costlier than matching it
+  static const std::regex number_regex{
+      "((\\+|-)?[[:digit:]]+)(\\.(([[:digit:]]+)?))?"};
+  return std::regex_match(a_token, number_regex);
 }
 
 // Checks if a string is a number.
@@ -0,0 +1,53 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <algorithm>
+#include <utility>
+
+#include "readCon/include/helpers/ThreadPool.hpp"
+
+namespace yodecon::helpers::parallel {
+ThreadPool::ThreadPool(size_t a_nthreads) {
+  if (a_nthreads == 0) {
+    a_nthreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  // The thread calling parallel_for is the last worker
+  for (size_t idx{1}; idx < a_nthreads; idx++) {
+    m_workers.emplace_back([this]() { worker_loop(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  for (auto &worker : m_workers) {
+    worker.join();
+  }
+}
+
+void ThreadPool::submit(std::function<void()> a_task) {
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_tasks.push_back(std::move(a_task));
+  }
+  m_cv.notify_one();
+}
+
+void ThreadPool::worker_loop() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock{m_mutex};
+      m_cv.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+      if (m_stop && m_tasks.empty()) {
+        return;
+      }
+      task = std::move(m_tasks.front());
+      m_tasks.pop_front();
+    }
+    task();
+  }
+}
+} // namespace yodecon::helpers::parallel
@@ -0,0 +1,327 @@
+#pragma once
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+// clang-format off
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+// clang-format on
+
+#include "readCon/include/WriteCon.hpp"
+
+namespace yodecon {
+//! Frames accepted by AsyncConWriter before write() blocks
+constexpr size_t DefaultQueuedFrames{8};
+//! Buffers cycled between formatting and writing by AsyncConWriter
+constexpr size_t DefaultWriteBuffers{2};
+
+/**
+ * @class AsyncConWriter
+ * @brief Writes `.con` frames from background threads.
+ *
+ * write() only moves the frame into a bounded queue. A formatting thread
+ * turns queued frames into text (see format_con()) in one of a fixed set of
+ * reused buffers, and hands each full buffer to an I/O thread, which writes
+ * it out with a single call and returns it. Formatting and writing therefore
+ * overlap, and neither runs on the calling thread.
+ *
+ * Memory is bounded by `a_max_queued` frames plus `a_nbuffers` buffers of
+ * about `a_chunk_bytes`: write() blocks while the queue is full, and the
+ * formatter waits for a free buffer while every buffer is being written.
+ *
+ * Errors raised in the background (e.g. a full disk) are rethrown by the next
+ * call to write(), flush() or close().
+ *
+ * Example usage:
+ * @code
+ * yodecon::AsyncConWriter<yodecon::types::ConFrameVec> out{"neb.con"};
+ * for (size_t step{0}; step < nsteps; step++) {
+ *   out.write(driver.snapshot()); // Returns as soon as the frame is queued
+ * }
+ * out.close();
+ * @endcode
+ */
+template <typename ConFrameLike> class AsyncConWriter {
+public:
+  /**
+   * @brief Creates (or truncates) `a_fname` and starts the threads.
+   * @exception std::runtime_error Thrown if the file cannot be created.
+   */
+  explicit AsyncConWriter(const std::string &a_fname,
+                          size_t a_max_queued = DefaultQueuedFrames,
+                          size_t a_nbuffers = DefaultWriteBuffers,
+                          size_t a_chunk_bytes = WriteChunkBytes)
+      : m_owned{std::make_unique<std::ofstream>(
+            a_fname, std::ios::binary | std::ios::trunc)},
+        m_stream{m_owned.get()} {
+    if (!m_owned->is_open()) {
+      throw std::runtime_error("Failed to open the file");
+    }
+    start(a_max_queued, a_nbuffers, a_chunk_bytes);
+  }
+
+  //! Writes to `a_stream`, which must outlive the writer
+  explicit AsyncConWriter(std::ostream &a_stream,
+                          size_t a_max_queued = DefaultQueuedFrames,
+                          size_t a_nbuffers = DefaultWriteBuffers,
+                          size_t a_chunk_bytes = WriteChunkBytes)
+      : m_stream{&a_stream} {
+    start(a_max_queued, a_nbuffers, a_chunk_bytes);
+  }
+
+  //! Writes out the queued frames and stops the threads, ignoring errors
+  ~AsyncConWriter() {
+    try {
+      close();
+    } catch (...) {
+      // Destructors must not throw, call close() to see errors
+    }
+  }
+  AsyncConWriter(const AsyncConWriter &) = delete;
+  AsyncConWriter &operator=(const AsyncConWriter &) = delete;
+
+  /**
+   * @brief Queues `a_frame`, blocking only while the queue is full.
+   *
+   * Pass temporaries or `std::move` the frame in, an lvalue is copied.
+   *
+   * @exception std::runtime_error Thrown after close().
+   * @exception Rethrows an error raised in the background.
+   */
+  void write(ConFrameLike a_frame) {
+    {
+      std::unique_lock<std::mutex> lock{m_mutex};
+      m_caller_cv.wait(lock, [this]() {
+        return m_error || m_closed || m_frames.size() < m_max_queued;
+      });
+      rethrow_if_failed();
+      m_frames.push_back(std::move(a_frame));
+    }
+    m_formatter_cv.notify_one();
+  }
+
+  /**
+   * @brief Waits until every frame queued so far is written and the stream
+   * is flushed.
+   * @exception Rethrows an error raised in the background.
+   */
+  void flush() {
+    std::unique_lock<std::mutex> lock{m_mutex};
+    rethrow_if_failed();
+    const size_t generation = ++m_flush_requested;
+    m_formatter_cv.notify_one();
+    m_caller_cv.wait(lock, [this, generation]() {
+      return m_error || m_flush_done >= generation;
+    });
+    rethrow_if_failed();
+  }
+
+  /**
+   * @brief Flushes, then stops the threads. Further writes throw.
+   * @exception Rethrows an error raised in the background.
+   */
+  void close() {
+    if (!m_formatter.joinable()) {
+      return;
+    }
+    std::exception_ptr error;
+    try {
+      flush();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    {
+      std::lock_guard<std::mutex> lock{m_mutex};
+      m_closed = true;
+    }
+    m_formatter_cv.notify_all();
+    m_caller_cv.notify_all();
+    m_formatter.join();
+    {
+      std::lock_guard<std::mutex> lock{m_mutex};
+      m_io_stop = true;
+    }
+    m_io_cv.notify_all();
+    m_io.join();
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  //! Frames waiting to be formatted
+  size_t queued() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_frames.size();
+  }
+
+private:
+  // A formatted buffer, and the flush it completes (0 if none)
+  struct Chunk {
+    std::string bytes;
+    size_t flush{0};
+  };
+
+  void start(size_t a_max_queued, size_t a_nbuffers, size_t a_chunk_bytes) {
+    m_max_queued = std::max<size_t>(a_max_queued, 1);
+    m_chunk_bytes = a_chunk_bytes;
+    for (size_t idx{0}; idx < std::max<size_t>(a_nbuffers, 2); idx++) {
+      m_free.emplace_back();
+      m_free.back().reserve(m_chunk_bytes);
+    }
+    m_io = std::thread{[this]() { io_loop(); }};
+    m_formatter = std::thread{[this]() { format_loop(); }};
+  }
+
+  // Called with m_mutex held
+  void rethrow_if_failed() {
+    if (m_error) {
+      std::rethrow_exception(m_error);
+    }
+    if (m_closed) {
+      throw std::runtime_error("The writer has been closed");
+    }
+  }
+
+  void fail(std::exception_ptr a_error) {
+    {
+      std::lock_guard<std::mutex> lock{m_mutex};
+      if (!m_error) {
+        m_error = a_error;
+      }
+    }
+    m_caller_cv.notify_all();
+    m_formatter_cv.notify_all();
+    m_io_cv.notify_all();
+  }
+
+  // A free buffer, empty if the writer failed while waiting for one
+  std::string acquire() {
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_formatter_cv.wait(lock,
+                        [this]() { return m_error || !m_free.empty(); });
+    if (m_free.empty()) {
+      return {};
+    }
+    std::string buffer = std::move(m_free.front());
+    m_free.pop_front();
+    return buffer;
+  }
+
+  void hand_off(std::string &a_buffer, size_t a_flush) {
+    {
+      std::lock_guard<std::mutex> lock{m_mutex};
+      m_full.push_back(Chunk{std::move(a_buffer), a_flush});
+    }
+    m_io_cv.notify_one();
+    a_buffer = acquire();
+  }
+
+  void format_loop() {
+    std::string buffer = acquire();
+    size_t flush_seen{0};
+    while (true) {
+      ConFrameLike frame;
+      bool have_frame{false};
+      size_t flush{0};
+      {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_formatter_cv.wait(lock, [&]() {
+          return m_closed || !m_frames.empty() ||
+                 m_flush_requested != flush_seen;
+        });
+        if (!m_frames.empty()) {
+          frame = std::move(m_frames.front());
+          m_frames.pop_front();
+          have_frame = true;
+        } else if (m_flush_requested != flush_seen) {
+          flush = flush_seen = m_flush_requested;
+        } else {
+          return;
+        }
+      }
+      if (have_frame) {
+        m_caller_cv.notify_all();
+        try {
+          format_con(frame, buffer);
+        } catch (...) {
+          fail(std::current_exception());
+        }
+        if (buffer.size() >= m_chunk_bytes) {
+          hand_off(buffer, 0);
+        }
+      } else {
+        hand_off(buffer, flush);
+      }
+    }
+  }
+
+  void io_loop() {
+    while (true) {
+      Chunk chunk;
+      bool failed{false};
+      {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_io_cv.wait(lock, [this]() { return m_io_stop || !m_full.empty(); });
+        if (m_full.empty()) {
+          return;
+        }
+        chunk = std::move(m_full.front());
+        m_full.pop_front();
+        failed = static_cast<bool>(m_error);
+      }
+      if (!failed) {
+        m_stream->write(chunk.bytes.data(),
+                        static_cast<std::streamsize>(chunk.bytes.size()));
+        if (chunk.flush != 0) {
+          m_stream->flush();
+        }
+        if (!*m_stream) {
+          fail(std::make_exception_ptr(
+              std::runtime_error("Failed to write the trajectory")));
+        }
+      }
+      chunk.bytes.clear();
+      {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_free.push_back(std::move(chunk.bytes));
+        if (chunk.flush != 0) {
+          m_flush_done = chunk.flush;
+        }
+      }
+      m_formatter_cv.notify_one();
+      m_caller_cv.notify_all();
+    }
+  }
+
+  std::unique_ptr<std::ofstream> m_owned;
+  std::ostream *m_stream;
+  size_t m_max_queued{DefaultQueuedFrames};
+  size_t m_chunk_bytes{WriteChunkBytes};
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_caller_cv;
+  std::condition_variable m_formatter_cv;
+  std::condition_variable m_io_cv;
+  std::deque<ConFrameLike> m_frames;
+  std::deque<std::string> m_free;
+  std::deque<Chunk> m_full;
+  size_t m_flush_requested{0};
+  size_t m_flush_done{0};
+  bool m_closed{false};
+  bool m_io_stop{false};
+  std::exception_ptr m_error;
+
+  std::thread m_io;
+  std::thread m_formatter;
+};
+} // namespace yodecon
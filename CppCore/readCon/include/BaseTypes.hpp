@@ -2,6 +2,7 @@
 // MIT License
 // Copyright 2023--present Rohit Goswami <HaoZeke>
 #include <array>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -9,7 +10,7 @@
 namespace yodecon::types {
 
 /**
- * @struct AtomDatum
+ * @struct BasicAtomDatum
  * @brief Represents a single atom's data in a molecular structure.
  *
  * This structure contains the spatial coordinates, chemical symbol, fixed
@@ -21,14 +22,20 @@ namespace yodecon::types {
  * lightweight. Also, mass shouldn't be hard-coded into the structure, consider
  * isotopes.
  *
+ * The coordinates are stored as `Real`, AtomDatum keeps doubles while
+ * AtomDatumFloat halves their footprint for analysis which does not need more
+ * than single precision.
+ *
  * Example of creating an AtomDatum:
  * @code
  * AtomDatum atom("C", 1.0, 2.0, 3.0, false, 123);
  * @endcode
  */
-struct AtomDatum {
+template <typename Real> struct BasicAtomDatum {
+  using real_type = Real;
+
   std::string symbol; ///< Chemical symbol of the atom (e.g., "C" for Carbon).
-  double x, y,
+  Real x, y,
       z;         ///< Cartesian coordinates of the atom in the simulation space.
   bool is_fixed; ///< Flag indicating if the atom's position is fixed during the
                  ///< simulation.
@@ -36,7 +43,8 @@ struct AtomDatum {
   /**
    * @brief Default constructor initializing members to default values.
    */
-  AtomDatum() : symbol{"NaN"}, x{0}, y{0}, z{0}, is_fixed{false}, atom_id{0} {}
+  BasicAtomDatum()
+      : symbol{"NaN"}, x{0}, y{0}, z{0}, is_fixed{false}, atom_id{0} {}
   /**
    * @brief Parameterized constructor for setting all properties of the atom.
    * @param a_symbol Chemical symbol of the atom.
@@ -46,8 +54,8 @@ struct AtomDatum {
    * @param a_is_fixed Boolean flag to set the atom's fixed status.
    * @param a_atom_id Unique identifier for the atom.
    */
-  AtomDatum(std::string a_symbol, double a_x, double a_y, double a_z,
-            bool a_is_fixed, int a_atom_id)
+  BasicAtomDatum(std::string a_symbol, Real a_x, Real a_y, Real a_z,
+                 bool a_is_fixed, int a_atom_id)
       : symbol{a_symbol}, x{a_x}, y{a_y}, z{a_z}, is_fixed{a_is_fixed},
         atom_id{a_atom_id} {}
   //  Not sure I want / need functions here (C compatility considerations)
@@ -59,20 +67,55 @@ struct AtomDatum {
   // }
 };
 
+using AtomDatum = BasicAtomDatum<double>;
+using AtomDatumFloat = BasicAtomDatum<float>;
+
+/**
+ * @struct AtomDatumCompact
+ * @brief Packed alternative to AtomDatum, identifying the element by number.
+ *
+ * Without the `std::string` the record is 32 bytes with no heap storage, so two
+ * atoms share a cache line and full frame sweeps read a fraction of the memory
+ * needed for AtomDatum.
+ *
+ * Example of creating an AtomDatumCompact:
+ * @code
+ * AtomDatumCompact atom(6, 1.0, 2.0, 3.0, false, 123);
+ * @endcode
+ */
+struct AtomDatumCompact {
+  double x, y, z; ///< Cartesian coordinates of the atom.
+  int atom_id;    ///< Unique identifier for the atom within the simulation.
+  std::uint8_t atomic_number; ///< Element of the atom, e.g. 6 for Carbon.
+  bool is_fixed; ///< Flag indicating if the atom's position is fixed during the
+                 ///< simulation.
+  AtomDatumCompact()
+      : x{0}, y{0}, z{0}, atom_id{0}, atomic_number{0}, is_fixed{false} {}
+  AtomDatumCompact(std::uint8_t a_atomic_number, double a_x, double a_y,
+                   double a_z, bool a_is_fixed, int a_atom_id)
+      : x{a_x}, y{a_y}, z{a_z}, atom_id{a_atom_id},
+        atomic_number{a_atomic_number}, is_fixed{a_is_fixed} {}
+};
+
 /**
- * @struct ConFrame
+ * @struct BasicConFrame
  * @brief Structure to store configuration frame data in a compact form.
  *
  * This structure is designed to hold all relevant information about a
  * configuration frame, including header information, box dimensions and angles,
  * atom types, and atom-specific data.
  *
+ * The per atom record is a parameter, ConFrame keeps the symbol of each atom
+ * (AtomDatum) while ConFrameCompact stores packed AtomDatumCompact records.
+ *
  * @note Consider providing a constructor that initializes data from a file.
  *
  * @todo Implement constructor taking a file path for initialization.
  * @todo Remove the default constructor to enforce initialization integrity.
  */
-struct ConFrame {
+template <typename AtomT> struct BasicConFrame {
+  using atom_type = AtomT;
+
   std::array<std::string, 2> prebox_header;
   std::array<double, 3> boxl;
   std::array<double, 3> angles;
@@ -80,11 +123,15 @@ struct ConFrame {
   size_t natm_types;
   std::vector<size_t> natms_per_type;
   std::vector<double> masses_per_type;
-  std::vector<AtomDatum> atom_data;
+  std::vector<AtomT> atom_data;
 };
 
+using ConFrame = BasicConFrame<AtomDatum>;
+using ConFrameCompact = BasicConFrame<AtomDatumCompact>;
+using ConFrameFloat = BasicConFrame<AtomDatumFloat>;
+
 /**
- * @struct ConFrameVec
+ * @struct BasicConFrameVec
  * @brief Structure to store expanded configuration frame data with separate
  * vectors for each attribute.
  *
@@ -97,8 +144,13 @@ struct ConFrame {
  * the compact nature of ConFrame, making it suitable for operations that
  * require direct access to specific atom properties without the need to iterate
  * through an array of atom data.
+ *
+ * The coordinate columns are stored as `Real`, ConFrameVecFloat keeps them in
+ * single precision. Cell lengths, angles and masses stay double either way.
  */
-struct ConFrameVec {
+template <typename Real> struct BasicConFrameVec {
+  using real_type = Real;
+
   std::array<std::string, 2> prebox_header;
   std::array<double, 3> boxl;
   std::array<double, 3> angles;
@@ -107,9 +159,98 @@ struct ConFrameVec {
   std::vector<size_t> natms_per_type;
   std::vector<double> masses_per_type;
   std::vector<std::string> symbol;
+  std::vector<Real> x, y, z;
+  std::vector<bool> is_fixed;
+  std::vector<int> atom_id;
+};
+
+using ConFrameVec = BasicConFrameVec<double>;
+using ConFrameVecFloat = BasicConFrameVec<float>;
+
+/**
+ * @struct ConFrameVecTyped
+ * @brief ConFrameVec with interned symbols, one small type index per atom.
+ *
+ * Atoms of a component always share the symbol from its header line, so the
+ * symbols are kept once in `type_symbols` (one per component) and every atom
+ * only stores the index of its component. For large frames this replaces a
+ * `std::string` per atom (32 bytes, plus a copy each) by 2 bytes.
+ *
+ * @note Code written against ConFrameVec::symbol can use symbols(), which
+ * expands the table back into one string per atom.
+ */
+struct ConFrameVecTyped {
+  using type_index_t = std::uint16_t;
+
+  std::array<std::string, 2> prebox_header;
+  std::array<double, 3> boxl;
+  std::array<double, 3> angles;
+  std::array<std::string, 2> postbox_header;
+  size_t natm_types;
+  std::vector<size_t> natms_per_type;
+  std::vector<double> masses_per_type;
+  std::vector<std::string> type_symbols;  ///< Symbol of each component.
+  std::vector<type_index_t> type_index;   ///< Component of each atom.
   std::vector<double> x, y, z;
   std::vector<bool> is_fixed;
   std::vector<int> atom_id;
+
+  //! Symbol of the atom at `a_idx`, without copying
+  const std::string &symbol(size_t a_idx) const {
+    return type_symbols[type_index[a_idx]];
+  }
+  //! One symbol per atom, laid out like ConFrameVec::symbol
+  std::vector<std::string> symbols() const {
+    std::vector<std::string> result;
+    result.reserve(type_index.size());
+    for (auto idx : type_index) {
+      result.push_back(type_symbols[idx]);
+    }
+    return result;
+  }
+};
+
+/**
+ * @struct FrameOffset
+ * @brief Location of a single frame within a (multi-frame) .con buffer.
+ *
+ * Produced by ConIndex, which only reads the header of each frame and skips
+ * the coordinate lines, so that a frame can later be parsed on its own. The
+ * box is kept as a cheap summary of the header.
+ */
+struct FrameOffset {
+  size_t offset; ///< Byte offset of the first header line.
+  size_t nbytes; ///< Length of the frame in bytes, including line terminators.
+  size_t natoms; ///< Total number of atoms, the sum of natms_per_type.
+  size_t natm_types;            ///< Number of components in the frame.
+  std::array<double, 3> boxl;   ///< Box lengths from the header.
+  std::array<double, 3> angles; ///< Box angles from the header.
+};
+
+/**
+ * @struct ConSummary
+ * @brief Per frame header summary of a trajectory, one column per field.
+ *
+ * Produced by scan_con without converting any coordinates, for when only the
+ * shape of a trajectory matters (e.g. to size jobs or allocate storage).
+ */
+struct ConSummary {
+  std::vector<size_t> natoms;               ///< Atoms in each frame.
+  std::vector<size_t> natm_types;           ///< Components in each frame.
+  std::vector<std::array<double, 3>> boxl;  ///< Box lengths of each frame.
+  std::vector<std::array<double, 3>> angles; ///< Box angles of each frame.
+
+  //! Number of frames
+  size_t size() const noexcept { return natoms.size(); }
+  bool empty() const noexcept { return natoms.empty(); }
+  //! Atoms summed over every frame
+  size_t total_atoms() const noexcept {
+    size_t total{0};
+    for (auto natms : natoms) {
+      total += natms;
+    }
+    return total;
+  }
 };
 
 namespace known_info {
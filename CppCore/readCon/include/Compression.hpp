@@ -0,0 +1,94 @@
+#pragma once
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "readcon_conf.h"
+
+namespace yodecon::compression {
+//! Compression formats recognised from the leading magic bytes of a file
+enum class Codec { None, Gzip, Xz, Zstd };
+
+//! Number of leading bytes needed to recognise every codec
+constexpr size_t MagicLength{6};
+
+/**
+ * @brief Recognises the codec from the first bytes of some input.
+ *
+ * Plain `.con` text starts with a comment line, which never matches any of
+ * the magic numbers, so anything unrecognised is Codec::None.
+ */
+Codec detect_codec(std::string_view a_head) noexcept;
+
+/**
+ * @brief Recognises the codec of the file `a_fname` from its magic bytes.
+ * @exception std::runtime_error Thrown if the file cannot be opened.
+ */
+Codec detect_codec_of(const std::string &a_fname);
+
+//! Whether support for `a_codec` was enabled at build time, e.g. through the
+//! `with_zlib`, `with_lzma` and `with_zstd` meson options
+bool is_supported(Codec a_codec) noexcept;
+
+//! Human readable name of `a_codec`, as used in error messages
+std::string_view codec_name(Codec a_codec) noexcept;
+
+/**
+ * @brief Decompresses `a_source` on the fly.
+ *
+ * The returned stream decodes a chunk at a time into a fixed size buffer, so
+ * memory stays bounded regardless of the size of the input. Concatenated
+ * members (e.g. from `cat a.con.gz b.con.gz`) are read as one stream.
+ *
+ * The returned stream is not seekable. Decoding errors, including input which
+ * ends partway through a compressed stream, are thrown from the reading call
+ * as `std::runtime_error`.
+ *
+ * @param a_source Compressed input, which must outlive the returned stream.
+ * @exception std::runtime_error Thrown if `a_codec` is not supported.
+ */
+std::unique_ptr<std::istream> decompress(std::istream &a_source,
+                                         Codec a_codec);
+
+/**
+ * @brief Compresses `a_data` into a single self-contained member of
+ * `a_codec`, i.e. a gzip member, an xz stream or a zstd frame.
+ *
+ * Members may be concatenated, the result still decompresses as a whole with
+ * the standard tools or with decompress().
+ *
+ * @exception std::runtime_error Thrown if `a_codec` is not supported, or is
+ * Codec::None.
+ */
+std::string compress(std::string_view a_data, Codec a_codec);
+
+/**
+ * @brief Decompresses the single member at the front of `a_in`, appending its
+ * contents to `a_out`. Anything in `a_in` after that member is not read.
+ *
+ * @return The number of compressed bytes the member occupies.
+ * @exception std::runtime_error Thrown if the member is corrupt or truncated,
+ * or `a_codec` is not supported.
+ */
+size_t decompress_member(std::string_view a_in, Codec a_codec,
+                         std::string &a_out);
+
+/**
+ * @brief Opens `a_fname` for reading, transparently decompressing it when its
+ * magic bytes name a supported codec.
+ *
+ * Example usage:
+ * @code
+ * auto input = yodecon::compression::open_input("neb.con.gz");
+ * yodecon::ConFrameStream<yodecon::types::ConFrameVec> frames{*input};
+ * @endcode
+ *
+ * @exception std::runtime_error Thrown if the file cannot be opened, or is
+ * compressed with a codec which was not enabled at build time.
+ */
+std::unique_ptr<std::istream> open_input(const std::string &a_fname);
+} // namespace yodecon::compression
@@ -1,13 +1,21 @@
-#ifdef WITH_ARROW
 #pragma once
 // MIT License
 // Copyright 2023--present Rohit Goswami <HaoZeke>
+#include "readcon_conf.h"
+
+#ifdef WITH_APACHE_ARROW
 // clang-format off
 #include <arrow/api.h>
+#include <array>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 // clang-format on
-#include "include/BaseTypes.hpp"
-#include "include/helpers/StringHelpers.hpp"
+#include "readCon/include/BaseTypes.hpp"
+#include "readCon/include/ConBinary.hpp"
+#include "readCon/include/helpers/StringHelpers.hpp"
+#include "readCon/include/helpers/ThreadPool.hpp"
 
 #define CHECK_ARROW_STATUS(status)                                             \
   do {                                                                         \
@@ -38,12 +46,108 @@ namespace yodecon::conarrow {
  * - Constructing the schema and metadata for the table.
  * - Creating and returning the final Arrow Table with all arrays and schema.
  *
+ * The columns are `symbol` (utf8), `x`, `y`, `z` (float64), `is_fixed`
+ * (boolean) and `atom_id` (uint64). These differ from the ConFrameVec
+ * overload, which ArrowFrameView expects, in the `symbol` and `atom_id`
+ * types.
+ *
  * @note Ensure that all Arrow status checks pass, otherwise, exceptions might
  * be thrown due to failed Arrow operations.
  */
 std::shared_ptr<arrow::Table>
 ConvertToArrowTable(const yodecon::types::ConFrame &conFrame);
 
+/**
+ * @brief Converts a ConFrameVec to an Apache Arrow Table without copying the
+ * coordinates.
+ *
+ * The `x`, `y`, `z` and `atom_id` vectors are moved into Arrow buffers, so
+ * the numeric columns take constant time to build and share their memory with
+ * what was parsed. `symbol` becomes a dictionary column, `int32` indices into
+ * the distinct symbols, and `is_fixed` is packed into a bitmap as Arrow
+ * requires. The schema metadata is that of the ConFrame overload.
+ *
+ * The columns are `symbol` (dictionary of utf8), `x`, `y`, `z` (float64, or
+ * float32 for ConFrameVecFloat), `is_fixed` (boolean) and `atom_id` (int32),
+ * matching the ConFrameVec fields rather than the ConFrame overload.
+ *
+ * Example usage:
+ * @code
+ * auto frame = yodecon::create_single_con<yodecon::types::ConFrameVec>(text);
+ * auto table = yodecon::conarrow::ConvertToArrowTable(std::move(frame));
+ * @endcode
+ *
+ * @note The columns of `a_frame` are left empty.
+ *
+ * @exception std::invalid_argument Thrown if the per atom columns of
+ * `a_frame` differ in length.
+ */
+std::shared_ptr<arrow::Table>
+ConvertToArrowTable(yodecon::types::ConFrameVec &&a_frame);
+
+//! Single precision variant, the coordinates become float32 columns
+std::shared_ptr<arrow::Table>
+ConvertToArrowTable(yodecon::types::ConFrameVecFloat &&a_frame);
+
+/**
+ * @struct TrajectoryTables
+ * @brief A whole trajectory as Apache Arrow Tables, see
+ * ConvertTrajectoryToArrow().
+ */
+struct TrajectoryTables {
+  //! Atoms of every frame, one chunk per frame
+  std::shared_ptr<arrow::Table> atoms;
+  //! One row per frame: `frame`, `natoms`, box lengths `a`, `b`, `c`, angles
+  //! `alpha`, `beta`, `gamma` and the rest of the header, `natm_types`
+  //! (int64), `natms_per_type` (list of uint64), `masses_per_type` (list of
+  //! float64), `prebox_header` and `postbox_header` (lists of two utf8 lines)
+  std::shared_ptr<arrow::Table> cells;
+};
+
+/**
+ * @brief Converts a trajectory to a single Arrow Table of atoms, plus a side
+ * table of the per frame cells.
+ *
+ * The atom table has a leading `frame` column (int64) followed by the columns
+ * of the ConFrameVec overload of ConvertToArrowTable(). Each frame is one
+ * chunk of every column, so `get_chunk_as_record_batch(tables.atoms, i)`
+ * returns frame `i`. The numeric columns are moved into Arrow buffers as for
+ * a single frame, and frames are converted on the threads of `a_pool`. All
+ * chunks share one symbol dictionary, as the IPC file format requires.
+ *
+ * Example usage:
+ * @code
+ * yodecon::helpers::parallel::ThreadPool pool{8};
+ * auto frames = yodecon::create_multi_con_parallel<
+ *     yodecon::types::ConFrameVec>(mapped.view(), 8);
+ * auto tables = yodecon::conarrow::ConvertTrajectoryToArrow(
+ *     std::move(frames), pool);
+ * auto last = yodecon::conarrow::get_chunk_as_record_batch(
+ *     tables.atoms, tables.atoms->column(0)->num_chunks() - 1);
+ * @endcode
+ *
+ * @note The columns of the frames in `a_frames` are left empty.
+ *
+ * Defined for ConFrameVec and ConFrameVecFloat.
+ *
+ * @exception std::invalid_argument Thrown if the per atom columns of a frame
+ * differ in length, or `natms_per_type` or `masses_per_type` lack an entry
+ * per component.
+ */
+template <typename Real>
+TrajectoryTables ConvertTrajectoryToArrow(
+    std::vector<yodecon::types::BasicConFrameVec<Real>> &&a_frames,
+    yodecon::helpers::parallel::ThreadPool &a_pool);
+
+//! Converts `a_frames` on `a_nthreads` threads, 0 uses every hardware thread
+template <typename Real>
+TrajectoryTables ConvertTrajectoryToArrow(
+    std::vector<yodecon::types::BasicConFrameVec<Real>> &&a_frames,
+    size_t a_nthreads = 0) {
+  yodecon::helpers::parallel::ThreadPool pool{a_nthreads};
+  return ConvertTrajectoryToArrow(std::move(a_frames), pool);
+}
+
 /**
  * @brief Retrieves a specified chunk from an Apache Arrow Table as a
  * RecordBatch.
@@ -77,6 +181,162 @@ ConvertToArrowTable(const yodecon::types::ConFrame &conFrame);
 std::shared_ptr<arrow::RecordBatch>
 get_chunk_as_record_batch(std::shared_ptr<arrow::Table> table, int chunk_index);
 
+/**
+ * @brief Writes `a_table` to `a_fname` as an Arrow IPC file (Feather V2).
+ *
+ * Each chunk becomes one record batch, so the frames of a trajectory table
+ * stay separate, and the schema metadata is stored with the schema. Buffers
+ * are left uncompressed so that read_ipc() can map them.
+ *
+ * @exception std::runtime_error Thrown if the file cannot be written.
+ */
+void write_ipc(const std::string &a_fname, const arrow::Table &a_table);
+
+/**
+ * @brief Memory maps the Arrow IPC file `a_fname` and returns its table.
+ *
+ * Nothing is parsed or copied, the columns point into the mapping, which
+ * stays alive as long as any of them does. Each record batch is one chunk,
+ * and the schema metadata is that of the table given to write_ipc().
+ *
+ * Example usage:
+ * @code
+ * if (!std::filesystem::exists("cuh2.arrow")) {
+ *   auto frame = yodecon::create_single_con<yodecon::types::ConFrameVec>(text);
+ *   yodecon::conarrow::write_ipc(
+ *       "cuh2.arrow",
+ *       *yodecon::conarrow::ConvertToArrowTable(std::move(frame)));
+ * }
+ * auto table = yodecon::conarrow::read_ipc("cuh2.arrow");
+ * yodecon::conarrow::ArrowFrameView view{
+ *     yodecon::conarrow::get_chunk_as_record_batch(table, 0)};
+ * @endcode
+ *
+ * @exception std::runtime_error Thrown if the file cannot be mapped or is not
+ * an Arrow IPC file.
+ */
+std::shared_ptr<arrow::Table> read_ipc(const std::string &a_fname);
+
+/**
+ * @class BasicArrowFrameView
+ * @brief A frame converted by the ConFrameVec or ConFrameVecFloat overload of
+ * ConvertToArrowTable(), or a frame of ConvertTrajectoryToArrow(), read in
+ * place.
+ *
+ * `Real` is the type of the coordinate columns, ArrowFrameView reads float64
+ * tables and ArrowFrameViewFloat float32 ones.
+ *
+ * The header is parsed back from the schema metadata, or for a trajectory
+ * read from its row of the cells table, and is proportional to the number of
+ * components. The coordinate and id columns are views of
+ * the Arrow buffers, e.g. into a file mapped by read_ipc(), and the view
+ * holds on to the batch, so they stay valid as long as it does.
+ *
+ * @note Header lines are stored comma separated, so a first prebox or
+ * postbox line containing a comma is not split back correctly.
+ */
+template <typename Real> class BasicArrowFrameView {
+public:
+  /**
+   * @brief Locates the columns of `a_batch` and reads its header.
+   * @exception std::invalid_argument Thrown if the batch lacks the header
+   * metadata (e.g. a chunk of a trajectory table, see the other
+   * constructor), a column, or has columns of other types or with nulls.
+   * Tables from the ConFrame overload of ConvertToArrowTable(), or with
+   * coordinates of the other precision, are named as such in the message.
+   */
+  explicit BasicArrowFrameView(std::shared_ptr<arrow::RecordBatch> a_batch);
+
+  /**
+   * @brief Views frame `a_row` of a trajectory from ConvertTrajectoryToArrow(),
+   * given its chunk of the atoms table, with the header read from row
+   * `a_row` of the cells table.
+   *
+   * Example usage:
+   * @code
+   * auto atoms = yodecon::conarrow::read_ipc("neb_atoms.arrow");
+   * auto cells = yodecon::conarrow::read_ipc("neb_cells.arrow");
+   * yodecon::conarrow::ArrowFrameView last{
+   *     yodecon::conarrow::get_chunk_as_record_batch(atoms, 4), *cells, 4};
+   * @endcode
+   *
+   * @exception std::out_of_range Thrown if `a_row` is not a row of `a_cells`.
+   * @exception std::invalid_argument As for the other constructor, or if the
+   * cells row is malformed or describes a different frame.
+   */
+  BasicArrowFrameView(std::shared_ptr<arrow::RecordBatch> a_atoms,
+                      const arrow::Table &a_cells, int64_t a_row);
+
+  size_t natoms() const noexcept {
+    return static_cast<size_t>(m_batch->num_rows());
+  }
+  size_t natm_types() const noexcept { return m_natm_types; }
+  const std::array<double, 3> &boxl() const noexcept { return m_boxl; }
+  const std::array<double, 3> &angles() const noexcept { return m_angles; }
+  const std::array<std::string, 2> &prebox_header() const noexcept {
+    return m_prebox_header;
+  }
+  const std::array<std::string, 2> &postbox_header() const noexcept {
+    return m_postbox_header;
+  }
+  const std::vector<size_t> &natms_per_type() const noexcept {
+    return m_natms_per_type;
+  }
+  const std::vector<double> &masses_per_type() const noexcept {
+    return m_masses_per_type;
+  }
+
+  /**
+   * @name Columns
+   * Views of the Arrow buffers, nothing is copied.
+   */
+  ///@{
+  conb::ColumnView<Real> x() const noexcept { return view(*m_x); }
+  conb::ColumnView<Real> y() const noexcept { return view(*m_y); }
+  conb::ColumnView<Real> z() const noexcept { return view(*m_z); }
+  conb::ColumnView<int32_t> atom_id() const noexcept {
+    return view(*m_atom_id);
+  }
+  ///@}
+  //! Symbol of atom `a_idx`, a view into the dictionary
+  std::string_view symbol(size_t a_idx) const;
+  bool is_fixed(size_t a_idx) const {
+    return m_is_fixed->Value(static_cast<int64_t>(a_idx));
+  }
+
+  //! Copies the frame out
+  types::BasicConFrameVec<Real> to_frame() const;
+
+private:
+  using RealArray =
+      arrow::NumericArray<typename arrow::CTypeTraits<Real>::ArrowType>;
+
+  void bind_columns();
+
+  template <typename ArrayT>
+  static conb::ColumnView<typename ArrayT::value_type>
+  view(const ArrayT &a_array) noexcept {
+    return {a_array.raw_values(), static_cast<size_t>(a_array.length())};
+  }
+
+  std::shared_ptr<arrow::RecordBatch> m_batch;
+  size_t m_natm_types{0};
+  std::array<double, 3> m_boxl{};
+  std::array<double, 3> m_angles{};
+  std::array<std::string, 2> m_prebox_header;
+  std::array<std::string, 2> m_postbox_header;
+  std::vector<size_t> m_natms_per_type;
+  std::vector<double> m_masses_per_type;
+  std::shared_ptr<arrow::DictionaryArray> m_symbol;
+  std::shared_ptr<arrow::StringArray> m_dictionary;
+  std::shared_ptr<RealArray> m_x, m_y, m_z;
+  std::shared_ptr<arrow::BooleanArray> m_is_fixed;
+  std::shared_ptr<arrow::Int32Array> m_atom_id;
+};
+
+using ArrowFrameView = BasicArrowFrameView<double>;
+using ArrowFrameViewFloat = BasicArrowFrameView<float>;
+
 } // namespace yodecon::conarrow
 
-#endif // WITH_ARROW
+#endif // WITH_APACHE_ARROW
@@ -0,0 +1,291 @@
+#pragma once
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <array>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "readCon/include/BaseTypes.hpp"
+#include "readCon/include/Helpers.hpp"
+
+namespace yodecon::conb {
+/**
+ * @brief Layout of the binary `.conb` trajectory format.
+ *
+ * Everything is little-endian. A 32 byte header is followed by the frames,
+ * and the frame table closes the file:
+ *
+ * | Field        | Type    | Notes                                        |
+ * |--------------+---------+----------------------------------------------|
+ * | magic        | char[8] | "RCONBIN" followed by a NUL                  |
+ * | version      | uint32  | FormatVersion                                |
+ * | reserved     | uint32  | Zero                                         |
+ * | nframes      | uint64  | Number of frames                             |
+ * | table_offset | uint64  | Byte offset of the frame table               |
+ *
+ * The table holds an offset and a size (both uint64) per frame. Each frame is
+ * stored column by column, in the order
+ *
+ * | Field           | Type                | Count       |
+ * |-----------------+---------------------+-------------|
+ * | natoms          | uint64              | 1           |
+ * | natm_types      | uint64              | 1           |
+ * | boxl, angles    | float64             | 3 each      |
+ * | header lines    | string              | 4           |
+ * | natms_per_type  | uint64              | natm_types  |
+ * | masses_per_type | float64             | natm_types  |
+ * | type symbols    | string              | natm_types  |
+ * | x, y, z         | float64             | natoms each |
+ * | atom_id         | int32               | natoms      |
+ * | is_fixed        | uint8               | natoms      |
+ *
+ * where a string is a uint64 length followed by its bytes, the header lines
+ * are the two prebox lines followed by the two postbox lines, and every field
+ * is padded to a multiple of 8 bytes. Frames and columns are therefore 8 byte
+ * aligned in the file and, once mapped, in memory.
+ */
+constexpr char Magic[8] = {'R', 'C', 'O', 'N', 'B', 'I', 'N', '\0'};
+constexpr uint32_t FormatVersion{1};
+constexpr size_t HeaderSize{32};
+constexpr size_t TableEntrySize{16};
+//! Alignment of every frame and field
+constexpr size_t Alignment{8};
+
+/**
+ * @class ColumnView
+ * @brief Read-only view of a column stored in a mapped `.conb` file.
+ */
+template <typename T> class ColumnView {
+public:
+  ColumnView() = default;
+  ColumnView(const T *a_data, size_t a_size) : m_data{a_data}, m_size{a_size} {}
+
+  const T *data() const noexcept { return m_data; }
+  size_t size() const noexcept { return m_size; }
+  bool empty() const noexcept { return m_size == 0; }
+  const T *begin() const noexcept { return m_data; }
+  const T *end() const noexcept { return m_data + m_size; }
+  const T &operator[](size_t a_idx) const noexcept { return m_data[a_idx]; }
+
+private:
+  const T *m_data{nullptr};
+  size_t m_size{0};
+};
+
+/**
+ * @class FrameView
+ * @brief One frame of a `.conb` file, read in place.
+ *
+ * Construction only locates the fields, which is proportional to the number
+ * of components. The columns point into the underlying bytes, so the view is
+ * only valid while those stay alive (e.g. the ConbReader).
+ */
+class FrameView {
+public:
+  /**
+   * @brief Locates the fields of the frame record `a_record`.
+   * @exception std::invalid_argument Thrown if the record is truncated or
+   * inconsistent.
+   */
+  explicit FrameView(std::string_view a_record);
+
+  size_t natoms() const noexcept { return m_natoms; }
+  size_t natm_types() const noexcept { return m_natm_types; }
+  const std::array<double, 3> &boxl() const noexcept { return m_boxl; }
+  const std::array<double, 3> &angles() const noexcept { return m_angles; }
+  const std::array<std::string_view, 2> &prebox_header() const noexcept {
+    return m_prebox_header;
+  }
+  const std::array<std::string_view, 2> &postbox_header() const noexcept {
+    return m_postbox_header;
+  }
+  //! Symbol of each component
+  const std::vector<std::string_view> &type_symbols() const noexcept {
+    return m_type_symbols;
+  }
+
+  /**
+   * @name Columns
+   * Views of the stored columns. These reinterpret the file bytes, and so
+   * need a little-endian host, which ConbReader::frame() checks.
+   */
+  ///@{
+  ColumnView<uint64_t> natms_per_type() const noexcept;
+  ColumnView<double> masses_per_type() const noexcept;
+  ColumnView<double> x() const noexcept;
+  ColumnView<double> y() const noexcept;
+  ColumnView<double> z() const noexcept;
+  ColumnView<int32_t> atom_id() const noexcept;
+  ColumnView<uint8_t> is_fixed() const noexcept;
+  ///@}
+
+  //! Copies the frame out, on any host
+  types::ConFrameVec to_frame() const;
+
+private:
+  size_t m_natoms;
+  size_t m_natm_types;
+  std::array<double, 3> m_boxl;
+  std::array<double, 3> m_angles;
+  std::array<std::string_view, 2> m_prebox_header;
+  std::array<std::string_view, 2> m_postbox_header;
+  std::vector<std::string_view> m_type_symbols;
+  const char *m_natms_per_type;
+  const char *m_masses_per_type;
+  const char *m_x;
+  const char *m_y;
+  const char *m_z;
+  const char *m_atom_id;
+  const char *m_is_fixed;
+};
+
+/**
+ * @brief Appends the `.conb` record of `a_frame` to `a_out`.
+ *
+ * The record is a multiple of Alignment bytes long, so records appended one
+ * after the other all stay aligned.
+ *
+ * @exception std::invalid_argument Thrown if the columns differ in length, do
+ * not add up to `natms_per_type`, or the atoms of a component do not share
+ * one symbol.
+ */
+void encode_frame(const types::ConFrameVec &a_frame, std::string &a_out);
+
+/**
+ * @class ConbWriter
+ * @brief Writes frames to a `.conb` file one at a time.
+ *
+ * Each frame is encoded into a reused buffer and written with a single call,
+ * the frame table and header follow in finish().
+ *
+ * Example usage:
+ * @code
+ * yodecon::conb::ConbWriter out{"neb.conb"};
+ * for (const auto &frame : frames) {
+ *   out.write(frame);
+ * }
+ * out.finish();
+ * @endcode
+ */
+class ConbWriter {
+public:
+  /**
+   * @brief Creates (or truncates) `a_fname`.
+   * @exception std::runtime_error Thrown if the file cannot be created.
+   */
+  explicit ConbWriter(const std::string &a_fname);
+  /**
+   * @brief Finishes the file if finish() was not called, ignoring errors.
+   *
+   * When destroyed by an exception unwinding the stack, or after a failed
+   * write, the incomplete file is discarded instead.
+   */
+  ~ConbWriter();
+  ConbWriter(const ConbWriter &) = delete;
+  ConbWriter &operator=(const ConbWriter &) = delete;
+
+  /**
+   * @brief Appends `a_frame`.
+   * @exception std::invalid_argument Thrown if the frame can not be encoded,
+   * see encode_frame().
+   * @exception std::runtime_error Thrown if writing fails.
+   */
+  void write(const types::ConFrameVec &a_frame);
+
+  /**
+   * @brief Writes the frame table and the header.
+   * @exception std::runtime_error Thrown if writing fails.
+   */
+  void finish();
+
+  //! Closes and removes the unfinished file, later calls do nothing
+  void discard() noexcept;
+
+  //! Frames written so far
+  size_t size() const noexcept { return m_offsets.size(); }
+
+private:
+  std::string m_fname;
+  std::ofstream m_out;
+  std::string m_buffer;
+  std::vector<uint64_t> m_offsets;
+  std::vector<uint64_t> m_nbytes;
+  uint64_t m_pos{HeaderSize};
+  bool m_finished{false};
+  bool m_failed{false};
+  // Exceptions in flight when constructed, more at destruction means unwinding
+  int m_uncaught{std::uncaught_exceptions()};
+};
+
+//! Writes `a_frames` to the `.conb` file `a_fname`, see ConbWriter
+void write_conb(const std::string &a_fname,
+                const std::vector<types::ConFrameVec> &a_frames);
+
+/**
+ * @brief Converts the `.con` trajectory `a_con`, which may be compressed, to
+ * the `.conb` file `a_conb`, one frame at a time.
+ * @return The number of frames converted.
+ * @exception std::invalid_argument Thrown for malformed frames, in which case
+ * no `a_conb` is left behind.
+ * @exception std::runtime_error Thrown if reading or writing fails, likewise
+ * without leaving `a_conb` behind.
+ */
+size_t convert_to_conb(const std::string &a_con, const std::string &a_conb);
+
+/**
+ * @class ConbReader
+ * @brief Maps a `.conb` file and hands out its frames.
+ *
+ * Opening only reads the header and the frame table. frame() returns views
+ * into the mapping, read_frame() copies a frame into a ConFrameVec.
+ *
+ * Example usage:
+ * @code
+ * yodecon::conb::ConbReader traj{"neb.conb"};
+ * auto last = traj.frame(traj.size() - 1);
+ * double sum{0};
+ * for (double val : last.x()) {
+ *   sum += val;
+ * }
+ * @endcode
+ */
+class ConbReader {
+public:
+  /**
+   * @exception std::runtime_error Thrown if the file cannot be opened.
+   * @exception std::invalid_argument Thrown if the file is not a readable
+   * `.conb` file, or its frame table is corrupt.
+   */
+  explicit ConbReader(const std::string &a_fname);
+
+  //! Number of frames
+  size_t size() const noexcept { return m_records.size(); }
+  bool empty() const noexcept { return m_records.empty(); }
+
+  /**
+   * @brief View of frame `a_idx`, read in place from the mapping.
+   * @exception std::out_of_range Thrown if `a_idx` is not a frame.
+   * @exception std::runtime_error Thrown on big-endian hosts, where the
+   * columns can not be used in place; read_frame() works everywhere.
+   */
+  FrameView frame(size_t a_idx) const;
+
+  /**
+   * @brief Copy of frame `a_idx`.
+   * @exception std::out_of_range Thrown if `a_idx` is not a frame.
+   */
+  types::ConFrameVec read_frame(size_t a_idx) const;
+
+  //! Copies of every frame
+  std::vector<types::ConFrameVec> read_all() const;
+
+private:
+  const std::string_view &record(size_t a_idx) const;
+  helpers::file::MappedFile m_mapped;
+  std::vector<std::string_view> m_records;
+};
+} // namespace yodecon::conb
@@ -0,0 +1,269 @@
+#pragma once
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <cstddef>
+#include <fstream>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "readCon/include/ConIndex.hpp"
+#include "readCon/include/ReadCon.hpp"
+
+namespace yodecon {
+/**
+ * @class FrameReader
+ * @brief Cuts an input stream into the raw bytes of successive frames.
+ *
+ * Input is read in chunks into a single reusable buffer. Frame boundaries are
+ * found from the headers (see scan_frame), and only the unread tail of the
+ * buffer is kept when more input is needed. Memory is therefore bounded by
+ * the largest frame plus a chunk, independent of the size of the input.
+ *
+ * Files compressed with a supported codec are decompressed on the fly (see
+ * compression::open_input), still within bounded memory.
+ *
+ * @note Views returned by next() are invalidated by the following call.
+ */
+class FrameReader {
+public:
+  static constexpr size_t DefaultChunkSize{size_t{1} << 20};
+
+  /**
+   * @brief Reads from the file `a_fname`, which may be compressed.
+   * @exception std::runtime_error Thrown if the file cannot be opened, or
+   * uses a compression codec which was not enabled at build time.
+   */
+  explicit FrameReader(const std::string &a_fname,
+                       size_t a_chunk_size = DefaultChunkSize);
+  //! Reads from `a_stream`, which must outlive the reader
+  explicit FrameReader(std::istream &a_stream,
+                       size_t a_chunk_size = DefaultChunkSize);
+
+  /**
+   * @brief Yields the bytes of the next frame.
+   * @return false once the input is exhausted.
+   * @exception std::invalid_argument Thrown if the input ends partway through
+   * a frame, or a header is malformed.
+   */
+  bool next(std::string_view &a_frame);
+
+  //! Stream offset just past the last frame handed out
+  size_t consumed() const noexcept { return m_consumed; }
+  //! Bytes read from the stream but not yet handed out
+  size_t pending() const noexcept { return m_end - m_begin; }
+  //! Current size of the internal buffer, the peak memory of the reader
+  size_t capacity() const noexcept { return m_buffer.size(); }
+
+protected:
+  /**
+   * @brief Extracts the next frame from what has been buffered so far,
+   * reading more input as long as the stream has some.
+   *
+   * @param a_final Whether the end of the stream is the end of the input. If
+   * not, an unterminated last line is treated as still being written.
+   */
+  bool extract(std::string_view &a_frame, bool a_final);
+  std::istream &stream() noexcept { return *m_stream; }
+  /**
+   * @brief Repositions a freshly opened reader to start at `a_offset`.
+   * @exception std::runtime_error Thrown if the stream cannot seek there.
+   */
+  void seek(size_t a_offset);
+
+private:
+  //! Reads at least one chunk, returns false if the stream had nothing left
+  bool fill();
+  std::unique_ptr<std::istream> m_owned;
+  std::istream *m_stream{nullptr};
+  size_t m_chunk_size;
+  std::string m_buffer;
+  size_t m_begin{0};
+  size_t m_end{0};
+  size_t m_consumed{0};
+};
+
+/**
+ * @class ConFrameStream
+ * @brief Constant memory iteration over the frames of a trajectory.
+ *
+ * Yields one parsed frame at a time, so only the current frame and the bounded
+ * buffer of a FrameReader are ever held in memory. Works for any ConFrameLike
+ * accepted by create_single_con.
+ *
+ * Example usage:
+ * @code
+ * yodecon::ConFrameStream<yodecon::types::ConFrameVec> frames{"md.con"};
+ * for (const auto &frame : frames) {
+ *   analyse(frame);
+ * }
+ * @endcode
+ */
+template <typename ConFrameLike> class ConFrameStream {
+public:
+  explicit ConFrameStream(
+      const std::string &a_fname,
+      size_t a_chunk_size = FrameReader::DefaultChunkSize)
+      : m_reader{a_fname, a_chunk_size} {}
+  explicit ConFrameStream(
+      std::istream &a_stream,
+      size_t a_chunk_size = FrameReader::DefaultChunkSize)
+      : m_reader{a_stream, a_chunk_size} {}
+
+  /**
+   * @brief Parses the next frame into `a_frame`.
+   * @return false once the input is exhausted.
+   */
+  bool next(ConFrameLike &a_frame) {
+    std::string_view bytes;
+    if (!m_reader.next(bytes)) {
+      return false;
+    }
+    a_frame = yodecon::create_single_con<ConFrameLike>(bytes);
+    return true;
+  }
+
+  const FrameReader &reader() const noexcept { return m_reader; }
+
+  /**
+   * @class iterator
+   * @brief Single pass input iterator over the remaining frames.
+   */
+  class iterator {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = ConFrameLike;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const ConFrameLike *;
+    using reference = const ConFrameLike &;
+
+    iterator() = default;
+    explicit iterator(ConFrameStream *a_parent) : m_parent{a_parent} {
+      ++(*this);
+    }
+    reference operator*() const { return m_parent->m_current; }
+    pointer operator->() const { return &m_parent->m_current; }
+    iterator &operator++() {
+      if (!m_parent->next(m_parent->m_current)) {
+        m_parent = nullptr;
+      }
+      return *this;
+    }
+    friend bool operator==(const iterator &a_lhs, const iterator &a_rhs) {
+      return a_lhs.m_parent == a_rhs.m_parent;
+    }
+    friend bool operator!=(const iterator &a_lhs, const iterator &a_rhs) {
+      return !(a_lhs == a_rhs);
+    }
+
+  private:
+    ConFrameStream *m_parent{nullptr};
+  };
+
+  //! Starts reading, each call continues where the last iteration stopped
+  iterator begin() { return iterator{this}; }
+  iterator end() { return iterator{}; }
+
+private:
+  FrameReader m_reader;
+  ConFrameLike m_current{};
+};
+
+/**
+ * @class FollowReader
+ * @brief A FrameReader for files which are still being appended to.
+ *
+ * Reaching the end of the file is not the end of the input: next() returns
+ * false until another complete frame has been written, and picks up from the
+ * same place on the following call. A partially written trailing frame, or
+ * even a partially written line, is held back until it is complete.
+ *
+ * @note A frame counts as complete once its last line is terminated, which is
+ * how eON writes its output.
+ */
+class FollowReader : public FrameReader {
+public:
+  /**
+   * @brief Follows `a_fname`, starting at the byte offset `a_offset`.
+   *
+   * Passing a previous consumed() value resumes following where an earlier
+   * reader (e.g. of a previous process) stopped, without rereading.
+   *
+   * @exception std::runtime_error Thrown if the file cannot be opened, is
+   * compressed, or is shorter than `a_offset`.
+   */
+  explicit FollowReader(const std::string &a_fname, size_t a_offset = 0,
+                        size_t a_chunk_size = DefaultChunkSize);
+
+  /**
+   * @brief Yields the next frame written so far.
+   * @return false if no further complete frame is available yet.
+   * @exception std::runtime_error Thrown if the file shrank below what has
+   * already been read, e.g. when a job restarted and truncated its output.
+   */
+  bool next(std::string_view &a_frame);
+
+private:
+  std::string m_fname;
+};
+
+/**
+ * @class ConFrameFollower
+ * @brief Incrementally parses the frames appended to a trajectory.
+ *
+ * Each poll() only reads and parses the bytes written since the previous one,
+ * so monitoring a running job costs time proportional to the new data rather
+ * than to the size of the file.
+ *
+ * Example usage:
+ * @code
+ * yodecon::ConFrameFollower<yodecon::types::ConFrameVec> follow{"neb.con"};
+ * while (job_running()) {
+ *   for (auto &frame : follow.poll()) {
+ *     update_dashboard(frame);
+ *   }
+ *   std::this_thread::sleep_for(std::chrono::seconds(5));
+ * }
+ * @endcode
+ */
+template <typename ConFrameLike> class ConFrameFollower {
+public:
+  explicit ConFrameFollower(
+      const std::string &a_fname, size_t a_offset = 0,
+      size_t a_chunk_size = FrameReader::DefaultChunkSize)
+      : m_reader{a_fname, a_offset, a_chunk_size} {}
+
+  /**
+   * @brief Parses the next completed frame into `a_frame`.
+   * @return false if no further complete frame is available yet.
+   */
+  bool next(ConFrameLike &a_frame) {
+    std::string_view bytes;
+    if (!m_reader.next(bytes)) {
+      return false;
+    }
+    a_frame = yodecon::create_single_con<ConFrameLike>(bytes);
+    return true;
+  }
+
+  //! Every frame completed since the last call
+  std::vector<ConFrameLike> poll() {
+    std::vector<ConFrameLike> result;
+    ConFrameLike frame{};
+    while (next(frame)) {
+      result.push_back(std::move(frame));
+    }
+    return result;
+  }
+
+  //! Byte offset after the last complete frame, to resume following later
+  size_t offset() const noexcept { return m_reader.consumed(); }
+
+private:
+  FollowReader m_reader;
+};
+} // namespace yodecon
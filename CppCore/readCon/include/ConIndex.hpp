@@ -0,0 +1,226 @@
+#pragma once
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "readCon/include/BaseTypes.hpp"
+#include "readCon/include/Helpers.hpp"
+#include "readCon/include/ParseOptions.hpp"
+#include "readCon/include/ReadCon.hpp"
+#include "readCon/include/helpers/ThreadPool.hpp"
+
+namespace yodecon {
+/**
+ * @class ConIndex
+ * @brief Byte offset index over the frames of a multi-frame .con buffer.
+ *
+ * Construction walks the buffer once, reading only the `natm_types` and
+ * `natms_per_type` header lines of each frame and skipping its coordinate
+ * lines without converting them. Afterwards any frame can be parsed on its
+ * own, so the cost of `read_frame(i)` does not depend on `i`.
+ *
+ * @note The index does not own the buffer, which must outlive it (typically a
+ * helpers::file::MappedFile view).
+ *
+ * Example usage:
+ * @code
+ * yodecon::helpers::file::MappedFile mapped{"neb.con"};
+ * yodecon::ConIndex index{mapped.view()};
+ * auto frame = index.read_frame<yodecon::types::ConFrameVec>(index.size() - 1);
+ * @endcode
+ */
+class ConIndex {
+public:
+  ConIndex() = default;
+
+  /**
+   * @brief Scans every frame of `a_fconts`.
+   *
+   * @exception std::invalid_argument Thrown if a header is malformed, a
+   * frame has fewer lines than its header promises, or `a_fconts` starts with
+   * the magic bytes of a compression codec.
+   */
+  explicit ConIndex(std::string_view a_fconts);
+
+  /**
+   * @brief Adopts previously computed offsets (e.g. from a sidecar file)
+   * without scanning.
+   *
+   * @exception std::invalid_argument Thrown if the offsets extend past the end
+   * of `a_fconts`, or `a_fconts` is compressed.
+   */
+  ConIndex(std::string_view a_fconts, std::vector<types::FrameOffset> a_frames);
+
+  /**
+   * @brief Rebinds the index to a grown copy of the same buffer and scans only
+   * the bytes past the last indexed frame.
+   *
+   * Used when a trajectory has been appended to since it was indexed, the
+   * already indexed prefix is assumed to be unchanged.
+   *
+   * @return The number of newly indexed frames.
+   * @exception std::invalid_argument Thrown if `a_fconts` is shorter than the
+   * indexed prefix or ends in a truncated frame.
+   */
+  size_t extend(std::string_view a_fconts);
+
+  //! The indexed buffer
+  std::string_view fconts() const noexcept { return m_fconts; }
+
+  //! Bytes covered by the indexed frames, where the next frame would start
+  size_t indexed_bytes() const noexcept {
+    return m_frames.empty() ? 0
+                            : m_frames.back().offset + m_frames.back().nbytes;
+  }
+
+  size_t size() const noexcept { return m_frames.size(); }
+  bool empty() const noexcept { return m_frames.empty(); }
+  const std::vector<types::FrameOffset> &frames() const noexcept {
+    return m_frames;
+  }
+
+  /**
+   * @brief Offset entry of frame `a_idx`.
+   * @exception std::out_of_range Thrown for indices past the last frame.
+   */
+  const types::FrameOffset &at(size_t a_idx) const {
+    return m_frames.at(a_idx);
+  }
+
+  //! The bytes of frame `a_idx`, a view into the indexed buffer
+  std::string_view frame_view(size_t a_idx) const {
+    const auto &entry = at(a_idx);
+    return m_fconts.substr(entry.offset, entry.nbytes);
+  }
+
+  //! Parses only frame `a_idx`
+  template <typename ConFrameLike>
+  ConFrameLike read_frame(size_t a_idx) const {
+    return yodecon::create_single_con<ConFrameLike>(frame_view(a_idx));
+  }
+
+private:
+  std::string_view m_fconts;
+  std::vector<types::FrameOffset> m_frames;
+};
+
+/**
+ * @brief Locates the frame starting at the cursor without parsing coordinates.
+ *
+ * Reads the 9 header lines, sums `natms_per_type` and skips the component
+ * headers and atom lines. On success the cursor is left at the start of the
+ * next frame.
+ *
+ * @param a_cursor Cursor positioned at the first header line of a frame.
+ * @param a_entry Filled with the frame offset, size and atom count.
+ * @return false if the buffer ends before the frame is complete, in which case
+ * the cursor position is unspecified.
+ *
+ * @exception std::invalid_argument Thrown if the header is malformed.
+ */
+bool scan_frame(yodecon::helpers::string::LineCursor &a_cursor,
+                types::FrameOffset &a_entry);
+
+/**
+ * @brief Advances the cursor to the next frame selected by `a_slice`.
+ *
+ * Unselected frames are skipped with scan_frame, from their header line counts
+ * alone, without converting any coordinates.
+ *
+ * @param a_cursor Cursor at the start of frame `a_idx`.
+ * @param a_idx Index of the frame at the cursor, updated to the selected one.
+ * @return false once no further frame is selected.
+ *
+ * @exception std::invalid_argument Thrown if the step is zero, or a skipped
+ * frame is malformed or truncated.
+ */
+bool next_selected(yodecon::helpers::string::LineCursor &a_cursor,
+                   const FrameSlice &a_slice, size_t &a_idx);
+
+/**
+ * @brief Parses only the frames of `a_fconts` selected by `a_slice`.
+ *
+ * The conversion work is proportional to the number of selected frames, the
+ * others only cost a newline count. Reading stops at `a_slice.stop`.
+ *
+ * @exception std::invalid_argument As for next_selected and
+ * create_single_con.
+ */
+template <typename ConFrameLike>
+std::vector<ConFrameLike> create_multi_con_slice(std::string_view a_fconts,
+                                                 const FrameSlice &a_slice) {
+  std::vector<ConFrameLike> result;
+  yodecon::helpers::string::LineCursor cursor{a_fconts};
+  size_t idx{0};
+  while (next_selected(cursor, a_slice, idx)) {
+    result.push_back(create_single_con<ConFrameLike>(cursor));
+    ++idx;
+  }
+  return result;
+}
+
+//! Parses the frames selected by `a_slice`, restricted by `a_opts`
+template <typename ConFrameLike>
+std::vector<ConFrameLike> create_multi_con_slice(std::string_view a_fconts,
+                                                 const FrameSlice &a_slice,
+                                                 const ParseOptions &a_opts) {
+  std::vector<ConFrameLike> result;
+  yodecon::helpers::string::LineCursor cursor{a_fconts};
+  size_t idx{0};
+  while (next_selected(cursor, a_slice, idx)) {
+    result.push_back(create_single_con<ConFrameLike>(cursor, a_opts));
+    ++idx;
+  }
+  return result;
+}
+
+/**
+ * @brief Parses every indexed frame on the threads of `a_pool`.
+ *
+ * Each frame is parsed independently from its own slice of the buffer and
+ * written into its slot of a pre-sized vector, so the result is identical to
+ * create_multi_con regardless of the thread count or scheduling.
+ *
+ * @exception Rethrows the first parse error of any frame.
+ */
+template <typename ConFrameLike>
+std::vector<ConFrameLike>
+read_frames(const ConIndex &a_index,
+            yodecon::helpers::parallel::ThreadPool &a_pool) {
+  std::vector<ConFrameLike> result(a_index.size());
+  a_pool.parallel_for(a_index.size(), [&](size_t a_idx) {
+    result[a_idx] = a_index.read_frame<ConFrameLike>(a_idx);
+  });
+  return result;
+}
+
+/**
+ * @brief Parallel counterpart of create_multi_con for a whole buffer.
+ *
+ * Finds the frame boundaries from the headers alone (see ConIndex) and then
+ * parses the frames on `a_nthreads` threads.
+ *
+ * @param a_fconts The trajectory, typically a helpers::file::MappedFile view.
+ * @param a_nthreads Number of threads, 0 uses every hardware thread.
+ * @exception std::invalid_argument As for ConIndex, in particular compressed
+ * buffers are rejected rather than decompressed.
+ *
+ * Example usage:
+ * @code
+ * yodecon::helpers::file::MappedFile mapped{"neb.con"};
+ * auto frames = yodecon::create_multi_con_parallel<
+ *     yodecon::types::ConFrameVec>(mapped.view(), 16);
+ * @endcode
+ */
+template <typename ConFrameLike>
+std::vector<ConFrameLike> create_multi_con_parallel(std::string_view a_fconts,
+                                                    size_t a_nthreads = 0) {
+  const ConIndex index{a_fconts};
+  yodecon::helpers::parallel::ThreadPool pool{a_nthreads};
+  return read_frames<ConFrameLike>(index, pool);
+}
+} // namespace yodecon
@@ -0,0 +1,105 @@
+#pragma once
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "readCon/include/ConIndex.hpp"
+
+namespace yodecon::idxfile {
+/**
+ * @brief Binary layout of the `.con.idx` sidecar.
+ *
+ * Everything is little-endian. A 56 byte header is followed by one fixed size
+ * record per frame:
+ *
+ * | Field         | Type       | Notes                                     |
+ * |---------------+------------+-------------------------------------------|
+ * | magic         | char[8]    | "RCONIDX" followed by a NUL               |
+ * | version       | uint32     | FormatVersion                             |
+ * | record_size   | uint32     | RecordSize                                |
+ * | file_size     | uint64     | Size of the trajectory when indexed       |
+ * | mtime         | int64      | Modification time when indexed            |
+ * | indexed_bytes | uint64     | End of the last indexed frame             |
+ * | tail_hash     | uint64     | FNV-1a of up to TailBytes before the end  |
+ * | nframes       | uint64     | Number of records which follow            |
+ *
+ * Each record holds offset, nbytes, natoms and natm_types as uint64 followed
+ * by boxl and angles as six float64, i.e. types::FrameOffset field by field.
+ */
+constexpr char Magic[8] = {'R', 'C', 'O', 'N', 'I', 'D', 'X', '\0'};
+constexpr uint32_t FormatVersion{1};
+constexpr size_t HeaderSize{56};
+constexpr uint32_t RecordSize{80};
+//! Bytes hashed to check that an appended trajectory kept its indexed prefix
+constexpr size_t TailBytes{4096};
+
+/**
+ * @struct SidecarInfo
+ * @brief The state of a trajectory file at the time it was indexed.
+ */
+struct SidecarInfo {
+  uint64_t file_size;
+  int64_t mtime;
+  uint64_t indexed_bytes;
+  uint64_t tail_hash;
+};
+
+//! The sidecar location for a trajectory, `a_fname` with `.idx` appended
+inline std::string sidecar_path(const std::string &a_fname) {
+  return a_fname + ".idx";
+}
+
+//! FNV-1a hash of the TailBytes bytes preceding `a_end` in `a_fconts`
+uint64_t tail_hash(std::string_view a_fconts, size_t a_end);
+
+/**
+ * @brief Writes `a_index` of the trajectory `a_fname` to its sidecar.
+ *
+ * The sidecar is written to a temporary file and renamed into place, so that
+ * concurrent readers never observe a partial index.
+ *
+ * @return false if the sidecar could not be written (e.g. a read-only
+ * directory), the index itself remains usable.
+ */
+bool write_sidecar(const std::string &a_fname, const ConIndex &a_index);
+
+/**
+ * @brief Reads the sidecar of `a_fname` without validating it.
+ *
+ * @param a_info Filled with the recorded state of the trajectory.
+ * @return The stored frame offsets, or std::nullopt if the sidecar is missing
+ * or not a readable version 1 index.
+ */
+std::optional<std::vector<types::FrameOffset>>
+read_sidecar(const std::string &a_fname, SidecarInfo &a_info);
+
+/**
+ * @brief Returns the index of a trajectory, reusing its sidecar when possible.
+ *
+ * - If the sidecar matches the current size and modification time of
+ *   `a_fname`, its offsets are used as is, without touching `a_fconts`.
+ * - If the file has grown and the bytes before the indexed end still hash to
+ *   the recorded value, only the appended frames are scanned.
+ * - Otherwise the index is rebuilt from scratch.
+ *
+ * Whenever the index changed it is written back when `a_write` is set.
+ *
+ * @param a_fname Path to the trajectory, used for the sidecar and file status.
+ * @param a_fconts The contents of `a_fname`, typically a
+ * helpers::file::MappedFile view.
+ * @param a_write Whether to (re)write the sidecar.
+ *
+ * Example usage:
+ * @code
+ * yodecon::helpers::file::MappedFile mapped{"neb.con"};
+ * auto index = yodecon::idxfile::load_or_build("neb.con", mapped.view());
+ * auto frame = index.read_frame<yodecon::types::ConFrameVec>(5000);
+ * @endcode
+ */
+ConIndex load_or_build(const std::string &a_fname, std::string_view a_fconts,
+                       bool a_write = true);
+} // namespace yodecon::idxfile
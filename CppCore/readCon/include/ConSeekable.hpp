@@ -0,0 +1,205 @@
+#pragma once
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "readCon/include/Compression.hpp"
+#include "readCon/include/ConIndex.hpp"
+
+namespace yodecon::seekable {
+/**
+ * @brief Layout of seekable compressed trajectories.
+ *
+ * The trajectory is cut into blocks of whole frames, and each block is
+ * compressed on its own, as a gzip member, xz stream or zstd frame. The
+ * blocks are simply concatenated, so the file is still an ordinary `.con.gz`,
+ * `.con.xz` or `.con.zst`, which the standard tools and
+ * compression::open_input decompress as a whole.
+ *
+ * Where each block starts is recorded in a sidecar next to the trajectory
+ * (see sidecar_path), little-endian, a 40 byte header followed by one record
+ * per block:
+ *
+ * | Field       | Type    | Notes                                         |
+ * |-------------+---------+-----------------------------------------------|
+ * | magic       | char[8] | "RCONBLK" followed by a NUL                   |
+ * | version     | uint32  | FormatVersion                                 |
+ * | codec       | uint32  | compression::Codec of every block             |
+ * | file_size   | uint64  | Size of the compressed trajectory             |
+ * | mtime       | int64   | Modification time of the trajectory           |
+ * | nblocks     | uint64  | Number of records which follow                |
+ *
+ * Each record holds offset, nbytes, first_frame, nframes and raw_bytes as
+ * uint64, i.e. BlockEntry field by field. A missing or stale sidecar is
+ * rebuilt by decompressing the blocks once.
+ */
+constexpr char Magic[8] = {'R', 'C', 'O', 'N', 'B', 'L', 'K', '\0'};
+constexpr uint32_t FormatVersion{1};
+constexpr size_t HeaderSize{40};
+constexpr size_t RecordSize{40};
+//! Frames per block unless told otherwise, a frame is the finest granularity
+constexpr size_t DefaultFramesPerBlock{1};
+
+/**
+ * @struct BlockEntry
+ * @brief Location of one compressed block and the frames it holds.
+ */
+struct BlockEntry {
+  uint64_t offset;      ///< Byte offset of the block in the compressed file
+  uint64_t nbytes;      ///< Compressed size of the block
+  uint64_t first_frame; ///< Index of the first frame in the block
+  uint64_t nframes;     ///< Number of frames in the block
+  uint64_t raw_bytes;   ///< Decompressed size of the block
+};
+
+//! The block index location for a trajectory, `a_fname` with `.bidx` appended
+inline std::string sidecar_path(const std::string &a_fname) {
+  return a_fname + ".bidx";
+}
+
+/**
+ * @class SeekableWriter
+ * @brief Writes a trajectory as independently compressed blocks of frames.
+ *
+ * Example usage:
+ * @code
+ * yodecon::helpers::file::MappedFile mapped{"neb.con"};
+ * yodecon::seekable::SeekableWriter out{
+ *     "neb.con.zst", yodecon::compression::Codec::Zstd, 4};
+ * out.write_frames(mapped.view());
+ * out.finish();
+ * @endcode
+ */
+class SeekableWriter {
+public:
+  /**
+   * @brief Creates (or truncates) `a_fname`.
+   * @param a_frames_per_block Frames compressed together, larger blocks
+   * compress better but every read decompresses a whole block.
+   * @exception std::runtime_error Thrown if the file cannot be created, or
+   * `a_codec` is not supported.
+   */
+  SeekableWriter(const std::string &a_fname, compression::Codec a_codec,
+                 size_t a_frames_per_block = DefaultFramesPerBlock);
+  /**
+   * @brief Finishes the file if finish() was not called, ignoring errors.
+   *
+   * When destroyed by an exception unwinding the stack, or after a failed
+   * write, the incomplete file is discarded instead.
+   */
+  ~SeekableWriter();
+  SeekableWriter(const SeekableWriter &) = delete;
+  SeekableWriter &operator=(const SeekableWriter &) = delete;
+
+  /**
+   * @brief Appends the frames in `a_fconts`, the text of one or more whole
+   * frames.
+   * @exception std::invalid_argument Thrown if `a_fconts` ends partway
+   * through a frame.
+   */
+  void write_frames(std::string_view a_fconts);
+
+  /**
+   * @brief Compresses the last partial block and writes the block index.
+   * @exception std::runtime_error Thrown if writing fails.
+   */
+  void finish();
+
+  //! Closes and removes the unfinished file, later calls do nothing
+  void discard() noexcept;
+
+  //! Frames written so far
+  size_t size() const noexcept { return m_nframes; }
+
+private:
+  void flush_block();
+  std::string m_fname;
+  compression::Codec m_codec;
+  size_t m_frames_per_block;
+  std::ofstream m_out;
+  std::string m_pending;
+  size_t m_pending_frames{0};
+  size_t m_nframes{0};
+  std::vector<BlockEntry> m_blocks;
+  bool m_finished{false};
+  bool m_failed{false};
+  // Exceptions in flight when constructed, more at destruction means unwinding
+  int m_uncaught{std::uncaught_exceptions()};
+};
+
+/**
+ * @brief Writes the block index of `a_fname` to its sidecar.
+ * @return false if the sidecar could not be written.
+ */
+bool write_sidecar(const std::string &a_fname, compression::Codec a_codec,
+                   const std::vector<BlockEntry> &a_blocks);
+
+/**
+ * @brief Recovers the block index of a concatenation of compressed members by
+ * decompressing each once.
+ * @exception std::invalid_argument Thrown if a member does not hold whole
+ * frames, i.e. the file was not written with frame aligned blocks.
+ */
+std::vector<BlockEntry> build_blocks(std::string_view a_compressed,
+                                     compression::Codec a_codec);
+
+/**
+ * @class SeekableReader
+ * @brief Random access to the frames of a seekable compressed trajectory.
+ *
+ * Reading frame `i` only decompresses the block holding it. The most recently
+ * decompressed block is kept, so walking neighbouring frames (e.g. the images
+ * of one NEB band) decompresses each block once.
+ *
+ * Example usage:
+ * @code
+ * yodecon::seekable::SeekableReader archive{"neb.con.zst"};
+ * auto last = archive.read_frame<yodecon::types::ConFrameVec>(
+ *     archive.size() - 1);
+ * @endcode
+ */
+class SeekableReader {
+public:
+  /**
+   * @brief Opens `a_fname`, reading its block index from the sidecar, or
+   * rebuilding (and writing back, when `a_write` is set) a missing or stale
+   * one.
+   * @exception std::runtime_error Thrown if the file cannot be opened or uses
+   * an unsupported codec.
+   */
+  explicit SeekableReader(const std::string &a_fname, bool a_write = true);
+
+  //! Number of frames
+  size_t size() const noexcept { return m_nframes; }
+  const std::vector<BlockEntry> &blocks() const noexcept { return m_blocks; }
+  compression::Codec codec() const noexcept { return m_codec; }
+
+  /**
+   * @brief The text of frame `a_idx`, decompressing its block if needed.
+   * @note The view is invalidated when another block is decompressed.
+   * @exception std::out_of_range Thrown if `a_idx` is not a frame.
+   */
+  std::string_view frame_view(size_t a_idx);
+
+  //! Parses frame `a_idx` into any ConFrameLike accepted by create_single_con
+  template <typename ConFrameLike> ConFrameLike read_frame(size_t a_idx) {
+    return create_single_con<ConFrameLike>(frame_view(a_idx));
+  }
+
+private:
+  //! Index into m_blocks of the block holding frame `a_idx`
+  size_t block_of(size_t a_idx) const;
+  helpers::file::MappedFile m_mapped;
+  compression::Codec m_codec;
+  std::vector<BlockEntry> m_blocks;
+  size_t m_nframes{0};
+  size_t m_cached_block;
+  std::string m_block;
+  ConIndex m_block_index;
+};
+} // namespace yodecon::seekable
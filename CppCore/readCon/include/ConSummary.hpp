@@ -0,0 +1,47 @@
+#pragma once
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "readCon/include/BaseTypes.hpp"
+
+namespace yodecon {
+/**
+ * @brief Summarizes every frame of a buffer from its header alone.
+ *
+ * Uses the same header scan as ConIndex: the box, `natm_types` and
+ * `natms_per_type` lines are read and the coordinate lines are skipped by
+ * counting newlines, so the cost is close to a single memchr pass.
+ *
+ * @exception std::invalid_argument Thrown if a header is malformed or the
+ * buffer ends within a frame.
+ */
+types::ConSummary scan_con(std::string_view a_fconts);
+
+//! Summary table from previously computed frame offsets
+types::ConSummary
+summarize_frames(const std::vector<types::FrameOffset> &a_frames);
+
+/**
+ * @brief Summarizes the trajectory `a_fname`.
+ *
+ * The file is memory mapped and scanned, unless its .con.idx sidecar is up to
+ * date, in which case the summary comes straight from the sidecar. The
+ * sidecar is never written. Compressed files are decompressed into memory
+ * and scanned, without consulting a sidecar.
+ *
+ * @exception std::runtime_error Thrown if the file cannot be opened, or is
+ * compressed with a codec which was not enabled at build time.
+ * @exception std::invalid_argument As for scan_con.
+ *
+ * Example usage:
+ * @code
+ * auto summary = yodecon::scan_con_file("neb.con");
+ * std::cout << summary.size() << " frames, " << summary.total_atoms()
+ *           << " atoms\n";
+ * @endcode
+ */
+types::ConSummary scan_con_file(const std::string &a_fname);
+} // namespace yodecon
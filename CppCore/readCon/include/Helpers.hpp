@@ -4,9 +4,13 @@
 // clang-format off
 #include <algorithm>
 // clang-format on
+#include <array>
+#include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -53,6 +57,8 @@ namespace string {
  * bool result = isNumber("-123.45"); // returns true
  * result = isNumber("abc"); // returns false
  * @endcode
+ *
+ * @note The parser itself no longer calls this, see parse_token.
  */
 bool isNumber(const std::string &a_token);
 
@@ -81,11 +87,102 @@ bool isNumber(const std::string &a_token);
  */
 std::vector<std::string> get_split_strings(const std::string &a_line);
 
+/**
+ * @class LineCursor
+ * @brief Forward-only line reader over a contiguous, non-owning buffer.
+ *
+ * The cursor hands out each line as a `std::string_view` into the underlying
+ * buffer, so walking a memory mapped file never allocates. Line terminators
+ * (`\n` and a preceding `\r`) are not part of the returned views.
+ *
+ * @note The buffer must outlive the cursor and every view obtained from it.
+ *
+ * Example usage:
+ * @code
+ * LineCursor cursor{"Cu\nCoordinates of Component 1\n"};
+ * std::string_view line;
+ * while (cursor.next(line)) {
+ *   std::cout << line << "\n";
+ * }
+ * @endcode
+ */
+class LineCursor {
+public:
+  LineCursor() = default;
+  explicit LineCursor(std::string_view a_buffer) : m_buffer{a_buffer} {}
+
+  /**
+   * @brief Advances past the next line.
+   * @param a_line Set to the line contents, without the terminator.
+   * @return false once the buffer is exhausted, in which case `a_line` is left
+   * untouched.
+   */
+  bool next(std::string_view &a_line) noexcept {
+    if (m_pos >= m_buffer.size()) {
+      return false;
+    }
+    const char *begin = m_buffer.data() + m_pos;
+    const size_t remaining = m_buffer.size() - m_pos;
+    const auto *newline =
+        static_cast<const char *>(std::memchr(begin, '\n', remaining));
+    size_t len = newline ? static_cast<size_t>(newline - begin) : remaining;
+    m_pos += newline ? len + 1 : len;
+    if (len > 0 && begin[len - 1] == '\r') {
+      --len;
+    }
+    a_line = std::string_view{begin, len};
+    return true;
+  }
+
+  /**
+   * @brief Advances past up to `a_nlines` lines without inspecting them.
+   * @return The number of lines actually skipped, less than `a_nlines` only
+   * when the buffer runs out.
+   */
+  size_t skip(size_t a_nlines) noexcept {
+    size_t nskipped{0};
+    while (nskipped < a_nlines && m_pos < m_buffer.size()) {
+      const char *begin = m_buffer.data() + m_pos;
+      const auto *newline = static_cast<const char *>(
+          std::memchr(begin, '\n', m_buffer.size() - m_pos));
+      m_pos = newline ? static_cast<size_t>(newline - m_buffer.data()) + 1
+                      : m_buffer.size();
+      nskipped++;
+    }
+    return nskipped;
+  }
+
+  //! True when only whitespace (or nothing) is left in the buffer
+  bool at_end() const noexcept {
+    for (size_t idx{m_pos}; idx < m_buffer.size(); ++idx) {
+      switch (m_buffer[idx]) {
+      case ' ':
+      case '\t':
+      case '\r':
+      case '\n':
+        continue;
+      default:
+        return false;
+      }
+    }
+    return true;
+  }
+
+  //! Byte offset of the next unread line from the start of the buffer
+  size_t offset() const noexcept { return m_pos; }
+  //! Number of bytes left after offset()
+  size_t remaining() const noexcept { return m_buffer.size() - m_pos; }
+
+private:
+  std::string_view m_buffer;
+  size_t m_pos{0};
+};
+
 template <typename T>
-std::vector<T> get_val_from_string(const std::string &a_line,
+std::vector<T> get_val_from_string(std::string_view a_line,
                                    std::optional<size_t> a_nelements);
 template <typename T, size_t N>
-std::array<T, N> get_array_from_string(const std::string &a_line);
+std::array<T, N> get_array_from_string(std::string_view a_line);
 } // namespace string
 
 namespace file {
@@ -104,11 +201,11 @@ namespace file {
  * @exception std::runtime_error Thrown if the file cannot be opened or the file
  * does not exist.
  *
- * @details The function first checks if the file exists and then attempts to
- * open it. If successful, it reads the contents into a string and then parses
- * this string into lines which are stored and returned in a vector. This
- * approach ensures that the file is read efficiently, handling large files by
- * reading them completely into memory before processing.
+ * @details The file is memory mapped (see MappedFile) and split into lines
+ * directly from the mapping, so the only copy made is the returned vector.
+ * Prefer parsing `MappedFile::view()` directly when the per-line strings are
+ * not needed. Compressed files (see compression::open_input) are decoded in
+ * chunks instead, without writing them out anywhere.
  *
  * Usage Example:
  * @code
@@ -123,6 +220,64 @@ namespace file {
  * @endcode
  */
 std::vector<std::string> read_con_file(const std::string &a_fname);
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a .con file.
+ *
+ * Maps the whole file into the address space so that the parser can work
+ * directly on the bytes the kernel pages in, without first copying them into
+ * strings. Peak memory is therefore bounded by the (shared, evictable) page
+ * cache rather than by a private copy of the file.
+ *
+ * @exception std::runtime_error Thrown if the file does not exist or cannot be
+ * mapped.
+ *
+ * Usage Example:
+ * @code
+ * yodecon::helpers::file::MappedFile mapped{"path/to/neb.con"};
+ * auto frames =
+ *     yodecon::create_multi_con<yodecon::types::ConFrameVec>(mapped.view());
+ * @endcode
+ *
+ * @note Empty files are valid and yield an empty view.
+ */
+class MappedFile {
+public:
+  explicit MappedFile(const std::string &a_fname);
+  ~MappedFile();
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  MappedFile(MappedFile &&a_other) noexcept;
+  MappedFile &operator=(MappedFile &&a_other) noexcept;
+
+  const char *data() const noexcept { return m_data; }
+  size_t size() const noexcept { return m_size; }
+  std::string_view view() const noexcept { return {m_data, m_size}; }
+
+private:
+  void release() noexcept;
+  const char *m_data{nullptr};
+  size_t m_size{0};
+#ifdef _WIN32
+  void *m_mapping{nullptr};
+#endif
+};
+
+//! Modification time of `a_fname` as a raw clock count, std::nullopt if it
+//! cannot be determined
+std::optional<int64_t> file_mtime(const std::string &a_fname);
+
+/**
+ * @brief Writes `a_bytes` to `a_fname` through a temporary file which is
+ * renamed into place, so that concurrent readers never observe a partial file.
+ *
+ * The temporary name is unique per call, so concurrent writers of the same
+ * file do not clobber each other, and it is removed on every failure.
+ *
+ * @return false if the file could not be written (e.g. a read-only directory).
+ */
+bool write_atomically(const std::string &a_fname, std::string_view a_bytes);
 } // namespace file
 
 namespace con {
@@ -0,0 +1,89 @@
+#pragma once
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace yodecon {
+/**
+ * @brief Bit flags naming the per atom columns of a ConFrameVec.
+ *
+ * Combine them with `|` to form the `columns` mask of ParseOptions.
+ */
+namespace columns {
+constexpr unsigned Symbol{1U << 0};
+constexpr unsigned X{1U << 1};
+constexpr unsigned Y{1U << 2};
+constexpr unsigned Z{1U << 3};
+constexpr unsigned IsFixed{1U << 4};
+constexpr unsigned AtomId{1U << 5};
+constexpr unsigned Positions{X | Y | Z};
+constexpr unsigned All{Symbol | Positions | IsFixed | AtomId};
+} // namespace columns
+
+/**
+ * @struct ParseOptions
+ * @brief Restricts what the parser materializes for each frame.
+ *
+ * The defaults reproduce the plain create_single_con output.
+ *
+ * When atoms are filtered, component blocks whose symbol is not selected are
+ * skipped by line count without converting any numbers, and only matching
+ * atoms are stored. The header of the resulting frame then describes the kept
+ * atoms: `natm_types`, `natms_per_type` and `masses_per_type` only list the
+ * components which still have atoms.
+ *
+ * Example usage:
+ * @code
+ * yodecon::ParseOptions opts;
+ * opts.columns = yodecon::columns::Positions;
+ * opts.symbols = {"H", "O"}; // Only the adsorbate, not the Cu slab
+ * auto frame = yodecon::create_single_con<yodecon::types::ConFrameVec>(
+ *     mapped.view(), opts);
+ * // frame.symbol, frame.is_fixed and frame.atom_id are left empty
+ * @endcode
+ */
+struct ParseOptions {
+  //! Columns to fill, unselected ones are not converted and stay empty. Only
+  //! honored by ConFrameVec, ConFrame always stores whole atoms.
+  unsigned columns{columns::All};
+  //! Component symbols to keep, every component when empty
+  std::vector<std::string> symbols;
+  //! Inclusive range of atom ids to keep, every atom when unset
+  std::optional<std::pair<int, int>> atom_ids;
+
+  //! Whether any atoms may be dropped
+  bool filters_atoms() const noexcept {
+    return !symbols.empty() || atom_ids.has_value();
+  }
+};
+
+/**
+ * @struct FrameSlice
+ * @brief Selects frames `start, start + step, ...` below `stop`, like a
+ * Python `start:stop:step` slice.
+ *
+ * Example usage:
+ * @code
+ * // Every 100th frame of a long trajectory
+ * auto preview = yodecon::create_multi_con_slice<yodecon::types::ConFrameVec>(
+ *     mapped.view(), yodecon::FrameSlice{0, yodecon::FrameSlice::End, 100});
+ * @endcode
+ */
+struct FrameSlice {
+  static constexpr size_t End{std::numeric_limits<size_t>::max()};
+
+  size_t start{0};  ///< First selected frame.
+  size_t stop{End}; ///< Frames from here on are not selected.
+  size_t step{1};   ///< Distance between selected frames, must be positive.
+
+  //! Whether frame `a_idx` is part of the slice
+  bool selects(size_t a_idx) const noexcept {
+    return a_idx >= start && a_idx < stop && (a_idx - start) % step == 0;
+  }
+};
+} // namespace yodecon
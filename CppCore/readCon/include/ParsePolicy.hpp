@@ -0,0 +1,36 @@
+#pragma once
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+
+namespace yodecon::policy {
+/**
+ * @brief Tags selecting how atom lines are validated, passed as the `Policy`
+ * template parameter of create_single_con and create_multi_con.
+ *
+ * The choice is made at compile time, each policy instantiates its own atom
+ * line loop, so the trusted path carries no checks at all. Headers are always
+ * validated, and the atom counts they give are always checked against the
+ * input, whatever the policy.
+ *
+ * Example usage:
+ * @code
+ * // Written by our own pipeline, skip validation
+ * auto frames = yodecon::create_multi_con<yodecon::types::ConFrameVec,
+ *                                         yodecon::policy::Trusted>(
+ *     mapped.view());
+ * @endcode
+ */
+
+//! The historical behaviour, non-numeric tokens are skipped and missing
+//! fields are left as zero
+struct Lenient {};
+
+//! Every atom line must hold exactly `x y z fixed id`, with a 0 or 1 fixed
+//! flag and an integral id, anything else throws `std::invalid_argument`
+struct Strict {};
+
+//! Converts the first five tokens without checking them, only for input known
+//! to be well formed. Malformed lines give unspecified values, never undefined
+//! behaviour.
+struct Trusted {};
+} // namespace yodecon::policy
@@ -3,9 +3,11 @@
 // Copyright 2023--present Rohit Goswami <HaoZeke>
 
 #include <algorithm>
+#include <array>
 #include <numeric>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "readcon_conf.h"
@@ -16,6 +18,9 @@
 
 #include "readCon/include/BaseTypes.hpp"
 #include "readCon/include/FormatConstants.hpp"
+#include "readCon/include/Helpers.hpp"
+#include "readCon/include/ParseOptions.hpp"
+#include "readCon/include/ParsePolicy.hpp"
 #include "readCon/include/helpers/StringHelpers.hpp"
 
 namespace yodecon {
@@ -78,18 +83,18 @@ namespace yodecon {
 template <typename Range, typename ConFrameLike>
 void process_header(const Range &a_header, ConFrameLike &conframe) {
   // TODO(rg): Move into a class later
-  std::vector<std::string> header_vec(a_header.begin(), a_header.end());
+  std::vector<std::string_view> header_vec(a_header.begin(), a_header.end());
   if (header_vec.size() != yodecon::constants::HeaderLength) {
     throw std::invalid_argument("Headers are always 9 lines for a con file");
   }
-  conframe.prebox_header[0] = header_vec[0];
-  conframe.prebox_header[1] = header_vec[1];
+  conframe.prebox_header[0] = std::string{header_vec[0]};
+  conframe.prebox_header[1] = std::string{header_vec[1]};
   conframe.boxl =
       yodecon::helpers::string::get_array_from_string<double, 3>(header_vec[2]);
   conframe.angles =
       yodecon::helpers::string::get_array_from_string<double, 3>(header_vec[3]);
-  conframe.postbox_header[0] = header_vec[4];
-  conframe.postbox_header[1] = header_vec[5];
+  conframe.postbox_header[0] = std::string{header_vec[4]};
+  conframe.postbox_header[1] = std::string{header_vec[5]};
   conframe.natm_types =
       (yodecon::helpers::string::get_array_from_string<size_t, 1>(
           header_vec[6]))[0];
@@ -101,12 +106,95 @@ void process_header(const Range &a_header, ConFrameLike &conframe) {
           header_vec[8], conframe.natm_types);
 }
 
+/**
+ * @brief Reads the next 9 lines from a cursor and parses them as a header.
+ *
+ * @exception std::invalid_argument Thrown if fewer than 9 lines remain, or for
+ * any of the reasons documented in process_header.
+ */
+template <typename ConFrameLike>
+void process_header(yodecon::helpers::string::LineCursor &a_cursor,
+                    ConFrameLike &conframe) {
+  std::array<std::string_view, yodecon::constants::HeaderLength> header;
+  for (auto &line : header) {
+    if (!a_cursor.next(line)) {
+      throw std::invalid_argument("Headers are always 9 lines for a con file");
+    }
+  }
+  yodecon::process_header(header, conframe);
+}
+
 // TODO(rg): Move into the ConFrame class later
+// The Real templates are instantiated for float and double in ReadCon.cc
+template <typename Real>
+void process_coordinates(
+    const std::vector<std::string> &a_filecontents,
+    yodecon::types::BasicConFrame<yodecon::types::BasicAtomDatum<Real>>
+        &conframe);
+
+template <typename Real>
 void process_coordinates(const std::vector<std::string> &a_filecontents,
-                         yodecon::types::ConFrame &conframe);
+                         yodecon::types::BasicConFrameVec<Real> &conframe);
 
 void process_coordinates(const std::vector<std::string> &a_filecontents,
-                         yodecon::types::ConFrameVec &conframe);
+                         yodecon::types::ConFrameVecTyped &conframe);
+
+void process_coordinates(const std::vector<std::string> &a_filecontents,
+                         yodecon::types::ConFrameCompact &conframe);
+
+/**
+ * @brief Parses the coordinate blocks following a header straight from a
+ * cursor, leaving it positioned at the start of the next frame.
+ *
+ * The header must already have been processed into `conframe`, since
+ * `natms_per_type` determines how many lines belong to the frame. Atom lines
+ * are validated as chosen by `Policy`, one of the tags in ParsePolicy.hpp.
+ *
+ * @exception std::invalid_argument Thrown if the cursor runs out of lines
+ * before every coordinate block has been read, or if `Policy` is
+ * policy::Strict and an atom line is malformed.
+ */
+template <typename Policy = yodecon::policy::Lenient, typename Real>
+void process_coordinates(
+    yodecon::helpers::string::LineCursor &a_cursor,
+    yodecon::types::BasicConFrame<yodecon::types::BasicAtomDatum<Real>>
+        &conframe);
+
+template <typename Policy = yodecon::policy::Lenient, typename Real>
+void process_coordinates(yodecon::helpers::string::LineCursor &a_cursor,
+                         yodecon::types::BasicConFrameVec<Real> &conframe);
+
+template <typename Policy = yodecon::policy::Lenient>
+void process_coordinates(yodecon::helpers::string::LineCursor &a_cursor,
+                         yodecon::types::ConFrameVecTyped &conframe);
+
+template <typename Policy = yodecon::policy::Lenient>
+void process_coordinates(yodecon::helpers::string::LineCursor &a_cursor,
+                         yodecon::types::ConFrameCompact &conframe);
+
+/**
+ * @brief Parses the coordinate blocks from a cursor, materializing only the
+ * atoms and columns selected by `a_opts`.
+ *
+ * Fields of an atom line are taken by position, and the line is only tokenized
+ * up to the last field needed. Unselected vectors are left empty, and rejected
+ * component blocks are skipped without conversion.
+ *
+ * @exception std::invalid_argument Thrown if the cursor runs out of lines
+ * before every coordinate block has been read, or a needed field is not a
+ * number.
+ */
+template <typename Real>
+void process_coordinates(
+    yodecon::helpers::string::LineCursor &a_cursor,
+    yodecon::types::BasicConFrame<yodecon::types::BasicAtomDatum<Real>>
+        &conframe,
+    const yodecon::ParseOptions &a_opts);
+
+template <typename Real>
+void process_coordinates(yodecon::helpers::string::LineCursor &a_cursor,
+                         yodecon::types::BasicConFrameVec<Real> &conframe,
+                         const yodecon::ParseOptions &a_opts);
 
 #ifdef WITH_RANGE_V3
 //! This function extracts con file information from a vector of strings
@@ -150,24 +238,96 @@ ConFrameLike create_single_con(const std::vector<std::string> &a_fconts) {
 }
 #endif
 
+//! This function extracts the con frame at the cursor, advancing past it,
+//! validating atom lines as chosen by `Policy` (see ParsePolicy.hpp)
+template <typename ConFrameLike, typename Policy = yodecon::policy::Lenient>
+ConFrameLike
+create_single_con(yodecon::helpers::string::LineCursor &a_cursor) {
+  ConFrameLike result;
+  yodecon::process_header(a_cursor, result);
+  yodecon::process_coordinates<Policy>(a_cursor, result);
+  return result;
+}
+
+//! This function extracts con file information from a buffer, typically a
+//! helpers::file::MappedFile view, without copying it into lines
+template <typename ConFrameLike, typename Policy = yodecon::policy::Lenient>
+ConFrameLike create_single_con(std::string_view a_fconts) {
+  yodecon::helpers::string::LineCursor cursor{a_fconts};
+  return create_single_con<ConFrameLike, Policy>(cursor);
+}
+
+//! Extracts the con frame at the cursor as restricted by `a_opts`, advancing
+//! past it
+template <typename ConFrameLike>
+ConFrameLike create_single_con(yodecon::helpers::string::LineCursor &a_cursor,
+                               const yodecon::ParseOptions &a_opts) {
+  ConFrameLike result;
+  yodecon::process_header(a_cursor, result);
+  yodecon::process_coordinates(a_cursor, result, a_opts);
+  return result;
+}
+
+//! Extracts the con frame in a buffer as restricted by `a_opts`
+template <typename ConFrameLike>
+ConFrameLike create_single_con(std::string_view a_fconts,
+                               const yodecon::ParseOptions &a_opts) {
+  yodecon::helpers::string::LineCursor cursor{a_fconts};
+  return create_single_con<ConFrameLike>(cursor, a_opts);
+}
+
 //! This function extracts a list of con data from a vector of strings
 template <typename ConFrameLike>
-std::vector<ConFrameLike> create_multi_con(std::vector<std::string> a_fconts) {
+std::vector<ConFrameLike>
+create_multi_con(const std::vector<std::string> &a_fconts) {
   std::vector<ConFrameLike> result;
-  while (!a_fconts.empty()) {
-    // Create a single con frame
-    ConFrameLike single_frame = create_single_con<ConFrameLike>(a_fconts);
-    // Add this frame to the results
-    result.push_back(single_frame);
-    // Calculate the number of lines this frame contained
-    size_t natmlines = std::accumulate(single_frame.natms_per_type.begin(),
-                                       single_frame.natms_per_type.end(), 0);
-    size_t nframelines = natmlines + yodecon::constants::HeaderLength +
-                         (single_frame.natm_types * 2);
-    // Ensure we don't try to erase more lines than exist in a_fconts
-    nframelines = std::min(nframelines, a_fconts.size());
-    // Erase the lines of the frame we just processed from a_fconts
-    a_fconts.erase(a_fconts.begin(), a_fconts.begin() + nframelines);
+  size_t start{0};
+  while (start < a_fconts.size()) {
+    // Size the frame from its header so only its own lines are copied, rather
+    // than erasing each frame from the front of the whole file
+    size_t nframelines{a_fconts.size() - start};
+    if (nframelines >= yodecon::constants::HeaderLength) {
+      const size_t natm_types =
+          yodecon::helpers::string::get_array_from_string<size_t, 1>(
+              a_fconts[start + 6])[0];
+      auto natms_per_type =
+          yodecon::helpers::string::get_val_from_string<size_t>(
+              a_fconts[start + 7], natm_types);
+      size_t natmlines = std::accumulate(natms_per_type.begin(),
+                                         natms_per_type.end(), size_t{0});
+      nframelines = std::min(nframelines,
+                             natmlines + yodecon::constants::HeaderLength +
+                                 (natm_types * 2));
+    }
+    std::vector<std::string> a_frame(a_fconts.begin() + start,
+                                     a_fconts.begin() + start + nframelines);
+    result.push_back(create_single_con<ConFrameLike>(a_frame));
+    start += nframelines;
+  }
+  return result;
+}
+
+//! This function extracts a list of con data from a buffer, typically a
+//! helpers::file::MappedFile view, walking it once without copying lines
+template <typename ConFrameLike, typename Policy = yodecon::policy::Lenient>
+std::vector<ConFrameLike> create_multi_con(std::string_view a_fconts) {
+  std::vector<ConFrameLike> result;
+  yodecon::helpers::string::LineCursor cursor{a_fconts};
+  while (!cursor.at_end()) {
+    result.push_back(create_single_con<ConFrameLike, Policy>(cursor));
+  }
+  return result;
+}
+
+//! Extracts every frame of a buffer as restricted by `a_opts`
+template <typename ConFrameLike>
+std::vector<ConFrameLike>
+create_multi_con(std::string_view a_fconts,
+                 const yodecon::ParseOptions &a_opts) {
+  std::vector<ConFrameLike> result;
+  yodecon::helpers::string::LineCursor cursor{a_fconts};
+  while (!cursor.at_end()) {
+    result.push_back(create_single_con<ConFrameLike>(cursor, a_opts));
   }
   return result;
 }
@@ -177,4 +337,27 @@ std::vector<int>
 symbols_to_atomic_numbers(const std::vector<std::string> &a_symbols);
 std::vector<std::string>
 atomic_numbers_to_symbols(const std::vector<int> &a_atomic_numbers);
+/**
+ * @brief Atomic number of every atom in `a_frame`.
+ *
+ * Only the `natm_types` interned symbols are looked up, each atom then takes
+ * the number of its component.
+ *
+ * @exception std::invalid_argument Thrown for unknown element symbols.
+ */
+std::vector<int>
+symbols_to_atomic_numbers(const yodecon::types::ConFrameVecTyped &a_frame);
+
+/**
+ * @brief Converts a frame to the packed per atom layout.
+ * @exception std::invalid_argument Thrown for unknown element symbols.
+ */
+yodecon::types::ConFrameCompact
+to_compact(const yodecon::types::ConFrame &a_frame);
+/**
+ * @brief Converts a packed frame back to one carrying per atom symbols.
+ * @exception std::invalid_argument Thrown for unknown atomic numbers.
+ */
+yodecon::types::ConFrame
+from_compact(const yodecon::types::ConFrameCompact &a_frame);
 } // namespace yodecon
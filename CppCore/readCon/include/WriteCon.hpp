@@ -0,0 +1,173 @@
+#pragma once
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "readCon/include/BaseTypes.hpp"
+#include "readCon/include/helpers/ThreadPool.hpp"
+
+namespace yodecon {
+//! Formatted bytes collected by ConWriter before they are written out
+constexpr size_t WriteChunkBytes{size_t{1} << 20};
+//! Atom lines formatted by each task of the parallel format_con
+constexpr size_t ParallelAtomsPerTask{size_t{1} << 15};
+
+/**
+ * @brief Appends the text of `a_frame` to `a_out`, laid out as eON writes it.
+ *
+ * That is the 9 line header (box lengths and angles as `%f`, tab separated),
+ * then per component its symbol, a `Coordinates of Component N` line and one
+ * `%22.17f %22.17f %22.17f %d %4d` line per atom. Numbers are converted with
+ * `std::to_chars`, which rounds exactly like `printf`, so frames written by
+ * eON are reproduced byte for byte.
+ *
+ * @note Coordinates keep 17 decimals, enough to read back the same double
+ * for any magnitude above about 0.1, as with eON itself.
+ *
+ * Defined for ConFrame, ConFrameFloat, ConFrameVec and ConFrameVecFloat.
+ *
+ * @exception std::invalid_argument Thrown if `natms_per_type` or
+ * `masses_per_type` do not have `natm_types` entries, `natms_per_type` does
+ * not add up to the atoms of the frame, or the atoms of a component do not
+ * share one symbol.
+ */
+template <typename ConFrameLike>
+void format_con(const ConFrameLike &a_frame, std::string &a_out);
+
+/**
+ * @brief Parallel counterpart of format_con for large frames.
+ *
+ * The atom lines of every component are cut into ranges of
+ * `a_atoms_per_task`, each formatted into its own buffer on the threads of
+ * `a_pool`. The buffers are then appended in order, so the text is byte for
+ * byte that of format_con regardless of the thread count. Frames with fewer
+ * atoms than a single task are formatted on the calling thread.
+ *
+ * @exception std::invalid_argument Thrown as by format_con.
+ */
+template <typename ConFrameLike>
+void format_con(const ConFrameLike &a_frame, std::string &a_out,
+                helpers::parallel::ThreadPool &a_pool,
+                size_t a_atoms_per_task = ParallelAtomsPerTask);
+
+/**
+ * @class ConWriter
+ * @brief Buffered `.con` output.
+ *
+ * Frames are formatted into one reused buffer, which goes out in a single
+ * `write` whenever it holds `a_chunk_bytes`, and on flush().
+ *
+ * Example usage:
+ * @code
+ * yodecon::ConWriter out{"neb.con"};
+ * for (const auto &frame : frames) {
+ *   out.write(frame);
+ * }
+ * out.flush();
+ * @endcode
+ */
+class ConWriter {
+public:
+  /**
+   * @brief Creates (or truncates) `a_fname`.
+   * @exception std::runtime_error Thrown if the file cannot be created.
+   */
+  explicit ConWriter(const std::string &a_fname,
+                     size_t a_chunk_bytes = WriteChunkBytes);
+  //! Writes to `a_stream`, which must outlive the writer
+  explicit ConWriter(std::ostream &a_stream,
+                     size_t a_chunk_bytes = WriteChunkBytes);
+  //! Flushes what is left, ignoring errors
+  ~ConWriter();
+  ConWriter(const ConWriter &) = delete;
+  ConWriter &operator=(const ConWriter &) = delete;
+
+  /**
+   * @brief Appends `a_frame`, see format_con().
+   * @exception std::runtime_error Thrown if writing a full chunk fails.
+   */
+  template <typename ConFrameLike> void write(const ConFrameLike &a_frame) {
+    format_con(a_frame, m_buffer);
+    if (m_buffer.size() >= m_chunk_bytes) {
+      flush();
+    }
+  }
+
+  //! Appends `a_frame`, formatting it on the threads of `a_pool`
+  template <typename ConFrameLike>
+  void write(const ConFrameLike &a_frame,
+             helpers::parallel::ThreadPool &a_pool) {
+    format_con(a_frame, m_buffer, a_pool);
+    if (m_buffer.size() >= m_chunk_bytes) {
+      flush();
+    }
+  }
+
+  /**
+   * @brief Writes out the buffered text and flushes the stream.
+   * @exception std::runtime_error Thrown if writing fails.
+   */
+  void flush();
+
+  //! Bytes handed to the stream so far
+  size_t bytes_written() const noexcept { return m_written; }
+
+private:
+  std::unique_ptr<std::ofstream> m_owned;
+  std::ostream *m_stream;
+  std::string m_buffer;
+  size_t m_chunk_bytes;
+  size_t m_written{0};
+};
+
+//! Writes `a_frame` to `a_stream`, see format_con()
+template <typename ConFrameLike>
+void write_con(std::ostream &a_stream, const ConFrameLike &a_frame) {
+  ConWriter out{a_stream};
+  out.write(a_frame);
+  out.flush();
+}
+
+//! Writes `a_frame` to `a_stream`, formatting it on the threads of `a_pool`
+template <typename ConFrameLike>
+void write_con(std::ostream &a_stream, const ConFrameLike &a_frame,
+               helpers::parallel::ThreadPool &a_pool) {
+  ConWriter out{a_stream};
+  out.write(a_frame, a_pool);
+  out.flush();
+}
+
+//! Writes `a_frame` to the file `a_fname`, see format_con()
+template <typename ConFrameLike>
+void write_con(const std::string &a_fname, const ConFrameLike &a_frame) {
+  ConWriter out{a_fname};
+  out.write(a_frame);
+  out.flush();
+}
+
+//! Writes the trajectory `a_frames` to `a_stream`, see format_con()
+template <typename ConFrameLike>
+void write_multi_con(std::ostream &a_stream,
+                     const std::vector<ConFrameLike> &a_frames) {
+  ConWriter out{a_stream};
+  for (const auto &frame : a_frames) {
+    out.write(frame);
+  }
+  out.flush();
+}
+
+//! Writes the trajectory `a_frames` to the file `a_fname`, see format_con()
+template <typename ConFrameLike>
+void write_multi_con(const std::string &a_fname,
+                     const std::vector<ConFrameLike> &a_frames) {
+  ConWriter out{a_fname};
+  for (const auto &frame : a_frames) {
+    out.write(frame);
+  }
+  out.flush();
+}
+} // namespace yodecon
@@ -0,0 +1,64 @@
+#pragma once
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace yodecon::helpers::bytes {
+// Little-endian encoding for the binary files written by readCon, independent
+// of the byte order of the host
+
+//! Whether the host stores integers and doubles little-endian, i.e. in the
+//! byte order of the files, so that their arrays can be used in place
+inline bool host_is_little_endian() noexcept {
+  const uint32_t probe{1};
+  unsigned char first{0};
+  std::memcpy(&first, &probe, 1);
+  return first == 1;
+}
+
+inline void put_u32(std::string &a_out, uint32_t a_val) {
+  for (size_t byte{0}; byte < 4; byte++) {
+    a_out.push_back(static_cast<char>((a_val >> (8 * byte)) & 0xFFU));
+  }
+}
+
+inline void put_u64(std::string &a_out, uint64_t a_val) {
+  for (size_t byte{0}; byte < 8; byte++) {
+    a_out.push_back(static_cast<char>((a_val >> (8 * byte)) & 0xFFU));
+  }
+}
+
+inline void put_f64(std::string &a_out, double a_val) {
+  uint64_t bits{0};
+  std::memcpy(&bits, &a_val, sizeof(bits));
+  put_u64(a_out, bits);
+}
+
+inline uint32_t get_u32(const char *a_ptr) {
+  uint32_t val{0};
+  for (size_t byte{0}; byte < 4; byte++) {
+    val |= static_cast<uint32_t>(static_cast<unsigned char>(a_ptr[byte]))
+           << (8 * byte);
+  }
+  return val;
+}
+
+inline uint64_t get_u64(const char *a_ptr) {
+  uint64_t val{0};
+  for (size_t byte{0}; byte < 8; byte++) {
+    val |= static_cast<uint64_t>(static_cast<unsigned char>(a_ptr[byte]))
+           << (8 * byte);
+  }
+  return val;
+}
+
+inline double get_f64(const char *a_ptr) {
+  uint64_t bits = get_u64(a_ptr);
+  double val{0};
+  std::memcpy(&val, &bits, sizeof(val));
+  return val;
+}
+} // namespace yodecon::helpers::bytes
@@ -3,7 +3,14 @@
 // Copyright 2023--present Rohit Goswami <HaoZeke>
 // clang-format off
 #include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <vector>
 #include <type_traits>
 #include <sstream>
@@ -11,6 +18,124 @@
 #include "readCon/include/Helpers.hpp"
 
 namespace yodecon::helpers::string {
+/**
+ * @brief Pulls the next whitespace-delimited token out of a line.
+ *
+ * @param a_rest The unread part of the line, advanced past the token.
+ * @param a_token Set to the token when one is found.
+ * @return false when only whitespace remains.
+ */
+inline bool next_token(std::string_view &a_rest,
+                       std::string_view &a_token) noexcept {
+  auto is_blank = [](char chr) {
+    return chr == ' ' || chr == '\t' || chr == '\r' || chr == '\n' ||
+           chr == '\v' || chr == '\f';
+  };
+  size_t begin{0};
+  while (begin < a_rest.size() && is_blank(a_rest[begin])) {
+    ++begin;
+  }
+  if (begin == a_rest.size()) {
+    a_rest = {};
+    return false;
+  }
+  size_t end{begin};
+  while (end < a_rest.size() && !is_blank(a_rest[end])) {
+    ++end;
+  }
+  a_token = a_rest.substr(begin, end - begin);
+  a_rest.remove_prefix(end);
+  return true;
+}
+
+/**
+ * @brief Converts a single token into a number using `std::from_chars`.
+ *
+ * The conversion is locale independent and never allocates. A leading `+` is
+ * accepted, and integral types also accept decimal tokens (truncated), which
+ * matches the historical stream based behaviour for fields like `is_fixed`.
+ *
+ * @return true if the whole token was consumed as a number, false for
+ * non-numeric tokens, including `nan` and `inf` for integral types and a
+ * second sign after the `+`.
+ *
+ * @exception std::invalid_argument Thrown if a negative number is converted
+ * into an unsigned type T, or a number lies outside the range of an integral
+ * type T.
+ */
+template <typename T>
+bool parse_token(std::string_view a_token, T &a_value) {
+  const char *first = a_token.data();
+  const char *last = first + a_token.size();
+  if (first != last && *first == '+') {
+    ++first;
+    if (first != last && (*first == '+' || *first == '-')) {
+      return false;
+    }
+  }
+  if constexpr (std::is_integral_v<T>) {
+    T ival{};
+    auto [iptr, iec] = std::from_chars(first, last, ival);
+    if (iec == std::errc{} && iptr == last) {
+      a_value = ival;
+      return true;
+    }
+  }
+  if constexpr (std::is_floating_point_v<T>) {
+    // Converted directly, a float is then correctly rounded rather than
+    // rounded twice through a double
+    T fval{};
+    auto [fptr, fec] = std::from_chars(first, last, fval);
+    if (fec != std::errc{} || fptr != last) {
+      return false;
+    }
+    a_value = fval;
+    return true;
+  }
+  double tmp{0};
+  auto [ptr, ec] = std::from_chars(first, last, tmp);
+  if (ec != std::errc{} || ptr != last || !std::isfinite(tmp)) {
+    return false;
+  }
+  if constexpr (std::is_unsigned_v<T>) {
+    if (tmp < 0) {
+      throw std::invalid_argument(
+          "Can't represent negative numbers with an unsigned type.");
+    }
+  }
+  // Casting a double outside the range of T is undefined, the bounds are
+  // powers of two and so exact as doubles
+  const double whole = std::trunc(tmp);
+  const double bound = std::ldexp(1.0, std::numeric_limits<T>::digits);
+  if (whole >= bound || (std::is_signed_v<T> && whole < -bound)) {
+    throw std::invalid_argument("Number out of range: " +
+                                std::string{a_token});
+  }
+  a_value = static_cast<T>(whole);
+  return true;
+}
+
+/**
+ * @brief Scans up to N numbers from a line into a preallocated array.
+ *
+ * Tokenizes and converts in a single pass over the line, without building any
+ * intermediate strings or streams. Non-numeric tokens are skipped, as in
+ * get_array_from_string.
+ *
+ * @return The number of values written into `a_out`.
+ */
+template <typename T, size_t N>
+size_t scan_numbers(std::string_view a_line, std::array<T, N> &a_out) {
+  std::string_view token;
+  size_t idx{0};
+  while (idx < N && next_token(a_line, token)) {
+    if (parse_token(token, a_out[idx])) {
+      idx++;
+    }
+  }
+  return idx;
+}
+
 /**
  * @brief Parses a string and converts it into a vector of values of type T.
  *
@@ -19,25 +144,20 @@ namespace yodecon::helpers::string {
  * a vector. This is useful for extracting typed data from strings, such as
  * reading numerical data from a line of text.
  *
- * @tparam T The type into which the string tokens will be converted. T must be
- * compatible with standard input stream operations.
+ * @tparam T The arithmetic type into which the string tokens will be
+ * converted.
  * @param a_line The string to parse.
  * @param nelements An optional parameter specifying the number of elements to
- * extract. If provided, the function will resize the resulting vector to this
- * size, which affects how many elements are converted.
+ * extract. If provided, only the first `nelements` tokens are considered.
  * @return std::vector<T> A vector of elements of type T extracted and converted
  * from the string.
  *
  * @exception std::invalid_argument Thrown if the input string is empty, if
- * `nelements` is zero or negative, if the string contains elements that cannot
- * be converted to type T, or if trying to convert a negative number into an
- * unsigned type T.
+ * `nelements` is zero or negative, or if trying to convert a negative number
+ * into an unsigned type T.
  *
- * @details The function splits the string into tokens using whitespace as
- * delimiters. Each token is checked to determine if it represents a valid
- * number. For unsigned types, it additionally validates that the number is not
- * negative. The function is robust against input errors, enforcing strong type
- * checks and constraints as defined by the template parameter.
+ * @details The function walks the whitespace-separated tokens of the line and
+ * converts each with parse_token, skipping tokens which are not numbers.
  *
  * Example usage:
  * @code
@@ -49,43 +169,26 @@ namespace yodecon::helpers::string {
  * @endcode
  */
 template <typename T>
-std::vector<T> get_val_from_string(const std::string &a_line,
+std::vector<T> get_val_from_string(std::string_view a_line,
                                    std::optional<size_t> nelements) {
   if (a_line.empty()) {
     throw std::invalid_argument("Line must not be empty.");
   }
 
   std::vector<T> retval;
-  const bool b_isunsigned{std::is_unsigned<T>::value};
-  auto elements{get_split_strings(a_line)};
-
+  size_t ntokens{std::numeric_limits<size_t>::max()};
   if (nelements.has_value()) {
     if (nelements.value() <= 0) {
       throw std::invalid_argument("Number of elements must be positive.");
     }
-    elements.resize(nelements.value());
+    ntokens = nelements.value();
+    retval.reserve(ntokens);
   }
 
-  for (const auto &elem : elements) {
-    if (!isNumber(elem)) {
-      continue;
-    }
-
-    std::istringstream ss{elem};
-
-    if (b_isunsigned) {
-      long double tmp{0};
-      ss >> tmp;
-
-      if (tmp < 0) {
-        throw std::invalid_argument(
-            "Can't represent negative numbers with an unsigned type.");
-      }
-
-      retval.push_back(static_cast<T>(tmp));
-    } else {
-      T tmp;
-      ss >> tmp;
+  std::string_view token;
+  for (size_t idx{0}; idx < ntokens && next_token(a_line, token); idx++) {
+    T tmp{};
+    if (parse_token(token, tmp)) {
       retval.push_back(tmp);
     }
   }
@@ -102,25 +205,21 @@ std::vector<T> get_val_from_string(const std::string &a_line,
  * data from a single line of text where the expected number of elements is
  * known and fixed.
  *
- * @tparam T The type into which the string tokens will be converted. T must
- * support standard input stream operations.
+ * @tparam T The arithmetic type into which the string tokens will be
+ * converted.
  * @tparam N The size of the array to return. This template parameter specifies
  * the expected number of elements that the input string should contain.
  * @param a_line The string to parse.
  * @return std::array<T, N> An array of elements of type T extracted and
  * converted from the string.
  *
- * @exception std::invalid_argument Thrown if the input string is empty, if a
- * token in the string cannot be converted to type T, or if trying to convert a
- * negative number into an unsigned type T when T is an unsigned type.
+ * @exception std::invalid_argument Thrown if the input string is empty, or if
+ * trying to convert a negative number into an unsigned type T.
  *
- * @details The function splits the string into tokens using whitespace as
- * delimiters. Each token is checked to determine if it represents a valid
- * number. The function parses up to N tokens into the resulting array. For
- * unsigned types, it additionally checks that the numbers are not negative. If
- * there are fewer tokens than N, the remaining elements of the array retain
- *          their default-initialized values. If more, they are ignored,
- * ensuring the array size matches N.
+ * @details A thin wrapper over scan_numbers. Non-numeric tokens are skipped. If
+ * there are fewer numbers than N, the remaining elements of the array are
+ * value initialized. If more, they are ignored, ensuring the array size matches
+ * N.
  *
  * Example usage:
  * @code
@@ -131,42 +230,13 @@ std::vector<T> get_val_from_string(const std::string &a_line,
  * @endcode
  */
 template <typename T, size_t N>
-std::array<T, N> get_array_from_string(const std::string &a_line) {
+std::array<T, N> get_array_from_string(std::string_view a_line) {
   if (a_line.empty()) {
     throw std::invalid_argument("Line must not be empty.");
   }
 
-  std::array<T, N> retval;
-  const bool b_isunsigned{std::is_unsigned<T>::value};
-  auto elements{get_split_strings(a_line)};
-
-  size_t idx{0};
-  for (const auto &elem : elements) {
-    if (!isNumber(elem)) {
-      continue;
-    }
-
-    std::istringstream ss{elem};
-
-    if (b_isunsigned) {
-      long double tmp{0};
-      ss >> tmp;
-
-      if (tmp < 0) {
-        throw std::invalid_argument(
-            "Can't represent negative numbers with an unsigned type.");
-      }
-
-      retval[idx] = static_cast<T>(tmp);
-      idx++;
-    } else {
-      T tmp;
-      ss >> tmp;
-      retval[idx] = tmp;
-      idx++;
-    }
-  }
-
+  std::array<T, N> retval{};
+  scan_numbers(a_line, retval);
   return retval;
 }
 /**
@@ -0,0 +1,108 @@
+#pragma once
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+// clang-format off
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+// clang-format on
+
+namespace yodecon::helpers::parallel {
+/**
+ * @class ThreadPool
+ * @brief Fixed size pool of worker threads with a blocking parallel_for.
+ *
+ * The pool is deliberately minimal, it exists so that the parallel loaders do
+ * not pay for spawning threads per call and so that a single pool can be
+ * shared across several loads.
+ *
+ * Example usage:
+ * @code
+ * yodecon::helpers::parallel::ThreadPool pool{8};
+ * std::vector<double> out(1000);
+ * pool.parallel_for(out.size(), [&](size_t idx) { out[idx] = idx * 2.0; });
+ * @endcode
+ */
+class ThreadPool {
+public:
+  /**
+   * @brief Starts the workers.
+   * @param a_nthreads Number of threads, 0 picks
+   * `std::thread::hardware_concurrency()`.
+   */
+  explicit ThreadPool(size_t a_nthreads = 0);
+  ~ThreadPool();
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  //! Number of threads taking part in parallel_for, including the caller
+  size_t size() const noexcept { return m_workers.size() + 1; }
+
+  /**
+   * @brief Calls `a_fn(idx)` for every `idx` in `[0, a_n)` and waits.
+   *
+   * Indices are handed out dynamically, so uneven work (e.g. frames of
+   * different sizes) stays balanced. The calling thread takes part in the
+   * loop. Each index is visited exactly once, in no particular order.
+   *
+   * @exception Rethrows the first exception thrown by `a_fn`, after every
+   * started call has finished.
+   */
+  template <typename Func> void parallel_for(size_t a_n, Func &&a_fn) {
+    std::atomic<size_t> next{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto drain = [&]() {
+      size_t idx{0};
+      while ((idx = next.fetch_add(1)) < a_n) {
+        try {
+          a_fn(idx);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock{error_mutex};
+          if (!error) {
+            error = std::current_exception();
+          }
+          // Let the remaining workers finish quickly
+          next.store(a_n);
+        }
+      }
+    };
+    const size_t nhelpers = std::min(m_workers.size(), a_n > 0 ? a_n - 1 : 0);
+    std::mutex done_mutex;
+    std::condition_variable done_cv;
+    size_t ndone{0};
+    for (size_t idx{0}; idx < nhelpers; idx++) {
+      submit([&]() {
+        drain();
+        std::lock_guard<std::mutex> lock{done_mutex};
+        ndone++;
+        done_cv.notify_one();
+      });
+    }
+    drain();
+    std::unique_lock<std::mutex> lock{done_mutex};
+    done_cv.wait(lock, [&]() { return ndone == nhelpers; });
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  //! Queues `a_task` to run on one of the workers
+  void submit(std::function<void()> a_task);
+
+private:
+  void worker_loop();
+  std::vector<std::thread> m_workers;
+  std::deque<std::function<void()>> m_tasks;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_stop{false};
+};
+} // namespace yodecon::helpers::parallel
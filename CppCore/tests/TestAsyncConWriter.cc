@@ -0,0 +1,101 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <filesystem>
+#include <sstream>
+
+#include "readCon/include/AsyncConWriter.hpp"
+#include "readCon/include/ReadCon.hpp"
+
+#include "TestHelpers.hpp"
+
+#include "catch2/catch_amalgamated.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+using yodecon::testing::load_frames;
+using yodecon::testing::read_plain;
+
+// Fifty copies of the frames of tiny_multi_cuh2, with distinct ids
+std::vector<yodecon::types::ConFrameVec> make_frames() {
+  const auto base = load_frames<yodecon::types::ConFrameVec>(
+      "test_data/tiny_multi_cuh2.con");
+  std::vector<yodecon::types::ConFrameVec> frames;
+  for (int copy{0}; copy < 50; copy++) {
+    for (auto frame : base) {
+      for (auto &atom_id : frame.atom_id) {
+        atom_id += 10 * copy;
+      }
+      frames.push_back(std::move(frame));
+    }
+  }
+  return frames;
+}
+} // namespace
+
+TEST_CASE("Background writes match the synchronous writer",
+          "[AsyncConWriter]") {
+  const auto frames = make_frames();
+  std::ostringstream expected;
+  yodecon::write_multi_con(expected, frames);
+
+  // Tiny queues, buffers and chunks so every wait is exercised
+  for (const size_t nbuffers : {2, 3}) {
+    for (const size_t chunk : {size_t{1}, size_t{700}, size_t{1} << 20}) {
+      std::ostringstream out;
+      yodecon::AsyncConWriter<yodecon::types::ConFrameVec> writer{
+          out, 2, nbuffers, chunk};
+      for (auto frame : frames) {
+        writer.write(std::move(frame));
+      }
+      writer.close();
+      REQUIRE(out.str() == expected.str());
+      REQUIRE_THROWS_AS(writer.write(frames[0]), std::runtime_error);
+    }
+  }
+}
+
+TEST_CASE("Flushed frames are on disk", "[AsyncConWriter]") {
+  const auto frames = make_frames();
+  const std::string fname = yodecon::testing::temp_name("async_test.con");
+  {
+    yodecon::AsyncConWriter<yodecon::types::ConFrameVec> writer{fname};
+    auto frame = frames[0];
+    writer.write(std::move(frame));
+    // Moved in, not copied
+    REQUIRE(frame.x.empty());
+    writer.flush();
+    std::ostringstream first;
+    yodecon::write_con(first, frames[0]);
+    REQUIRE(read_plain(fname) == first.str());
+    REQUIRE(writer.queued() == 0);
+
+    writer.write(frames[1]);
+  }
+  // The destructor wrote the rest
+  REQUIRE(yodecon::create_multi_con<yodecon::types::ConFrameVec>(
+              read_plain(fname))
+              .size() == 2);
+  fs::remove(fname);
+}
+
+TEST_CASE("Background errors reach the caller", "[AsyncConWriter]") {
+  auto frame = make_frames()[0];
+  {
+    std::ostringstream out;
+    yodecon::AsyncConWriter<yodecon::types::ConFrameVec> writer{out};
+    auto broken = frame;
+    broken.natms_per_type[0] += 1;
+    writer.write(std::move(broken));
+    REQUIRE_THROWS_AS(writer.flush(), std::invalid_argument);
+    REQUIRE_THROWS_AS(writer.write(frame), std::invalid_argument);
+    REQUIRE_THROWS_AS(writer.close(), std::invalid_argument);
+  }
+  {
+    // No buffer, every write fails
+    std::ostream nowhere{nullptr};
+    yodecon::AsyncConWriter<yodecon::types::ConFrameVec> writer{nowhere};
+    writer.write(frame);
+    REQUIRE_THROWS_AS(writer.flush(), std::runtime_error);
+  }
+}
@@ -0,0 +1,189 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <filesystem>
+#include <sstream>
+
+#include "readCon/include/Compression.hpp"
+#include "readCon/include/ConFrameStream.hpp"
+#include "readCon/include/ConIndexFile.hpp"
+#include "readCon/include/ConSummary.hpp"
+
+#ifdef WITH_ZLIB
+#include <zlib.h>
+#endif
+
+#include "TestHelpers.hpp"
+
+#include "catch2/catch_amalgamated.hpp"
+
+namespace {
+using yodecon::compression::Codec;
+using yodecon::testing::read_plain;
+using yodecon::testing::slurp;
+
+// Every codec with a fixture, compressed from tiny_multi_cuh2.con
+const std::vector<std::pair<Codec, std::string>> Fixtures{
+    {Codec::Gzip, "test_data/tiny_multi_cuh2.con.gz"},
+    {Codec::Xz, "test_data/tiny_multi_cuh2.con.xz"},
+    {Codec::Zstd, "test_data/tiny_multi_cuh2.con.zst"},
+};
+} // namespace
+
+TEST_CASE("Codecs are detected from magic bytes", "[Compression]") {
+  REQUIRE(yodecon::compression::detect_codec("Generated by eOn") ==
+          Codec::None);
+  REQUIRE(yodecon::compression::detect_codec("") == Codec::None);
+  REQUIRE(yodecon::compression::detect_codec_of(
+              "test_data/tiny_multi_cuh2.con") == Codec::None);
+  for (const auto &[codec, fname] : Fixtures) {
+    REQUIRE(yodecon::compression::detect_codec_of(fname) == codec);
+  }
+  REQUIRE(yodecon::compression::is_supported(Codec::None));
+  REQUIRE_THROWS_AS(
+      yodecon::compression::detect_codec_of("test_data/nope.con.gz"),
+      std::runtime_error);
+}
+
+TEST_CASE("Compressed input reads like the plain file", "[Compression]") {
+  const std::string plain = read_plain("test_data/tiny_multi_cuh2.con");
+  auto expected =
+      yodecon::create_multi_con<yodecon::types::ConFrameVec>(plain);
+  for (const auto &[codec, fname] : Fixtures) {
+    DYNAMIC_SECTION(yodecon::compression::codec_name(codec)) {
+      if (!yodecon::compression::is_supported(codec)) {
+        REQUIRE_THROWS_AS(yodecon::compression::open_input(fname),
+                          std::runtime_error);
+        REQUIRE_THROWS_AS(yodecon::helpers::file::read_con_file(fname),
+                          std::runtime_error);
+        continue;
+      }
+      auto input = yodecon::compression::open_input(fname);
+      REQUIRE(slurp(*input) == plain);
+
+      REQUIRE(yodecon::helpers::file::read_con_file(fname) ==
+              yodecon::helpers::file::read_con_file(
+                  "test_data/tiny_multi_cuh2.con"));
+
+      // Small chunks make frames straddle many decoded blocks
+      yodecon::ConFrameStream<yodecon::types::ConFrameVec> frames{fname, 7};
+      size_t nframes{0};
+      for (const auto &frame : frames) {
+        REQUIRE(frame.x == expected[nframes].x);
+        REQUIRE(frame.atom_id == expected[nframes].atom_id);
+        nframes++;
+      }
+      REQUIRE(nframes == expected.size());
+      REQUIRE_THROWS_AS(
+          yodecon::ConFrameFollower<yodecon::types::ConFrameVec>{fname},
+          std::runtime_error);
+    }
+  }
+}
+
+TEST_CASE("Mapped entry points recognise compressed input",
+          "[Compression]") {
+  const auto plain = yodecon::scan_con_file("test_data/tiny_multi_cuh2.con");
+  for (const auto &[codec, fname] : Fixtures) {
+    DYNAMIC_SECTION(yodecon::compression::codec_name(codec)) {
+      yodecon::helpers::file::MappedFile mapped{fname};
+      REQUIRE_THROWS_WITH(yodecon::ConIndex{mapped.view()},
+                          Catch::Matchers::ContainsSubstring("open_input"));
+      REQUIRE_THROWS_AS(
+          yodecon::idxfile::load_or_build(fname, mapped.view(), false),
+          std::invalid_argument);
+      REQUIRE_THROWS_AS(
+          yodecon::create_multi_con_parallel<yodecon::types::ConFrameVec>(
+              mapped.view(), 2),
+          std::invalid_argument);
+      if (!yodecon::compression::is_supported(codec)) {
+        REQUIRE_THROWS_AS(yodecon::scan_con_file(fname), std::runtime_error);
+        continue;
+      }
+      const auto summary = yodecon::scan_con_file(fname);
+      REQUIRE(summary.natoms == plain.natoms);
+      REQUIRE(summary.boxl == plain.boxl);
+      REQUIRE_FALSE(std::filesystem::exists(
+          yodecon::idxfile::sidecar_path(fname)));
+    }
+  }
+}
+
+TEST_CASE("Members round trip through compress", "[Compression]") {
+  // Several decoder chunks worth of text
+  std::string plain;
+  const std::string frame = read_plain("test_data/cuh2.con");
+  while (plain.size() < 4 * (size_t{1} << 16)) {
+    plain += frame;
+  }
+  for (const auto &[codec, fname] : Fixtures) {
+    if (!yodecon::compression::is_supported(codec)) {
+      continue;
+    }
+    const std::string member = yodecon::compression::compress(plain, codec);
+    REQUIRE(yodecon::compression::detect_codec(member) == codec);
+    std::string out;
+    // Trailing bytes past the member are left alone
+    REQUIRE(yodecon::compression::decompress_member(member + "tail", codec,
+                                                    out) == member.size());
+    REQUIRE(out == plain);
+  }
+}
+
+TEST_CASE("Truncated compressed input throws", "[Compression]") {
+  for (const auto &[codec, fname] : Fixtures) {
+    if (!yodecon::compression::is_supported(codec)) {
+      continue;
+    }
+    const std::string bytes = read_plain(fname);
+    std::istringstream truncated{bytes.substr(0, bytes.size() / 2)};
+    auto input = yodecon::compression::decompress(truncated, codec);
+    REQUIRE_THROWS_AS(slurp(*input), std::runtime_error);
+
+    // Reported as a decoding error, rather than as a truncated frame
+    truncated.clear();
+    truncated.seekg(0);
+    auto again = yodecon::compression::decompress(truncated, codec);
+    yodecon::ConFrameStream<yodecon::types::ConFrameVec> frames{*again};
+    yodecon::types::ConFrameVec frame;
+    REQUIRE_THROWS_AS(
+        [&] {
+          while (frames.next(frame)) {
+          }
+        }(),
+        std::runtime_error);
+  }
+}
+
+#ifdef WITH_ZLIB
+TEST_CASE("Large gzip trajectories stream in bounded memory",
+          "[Compression]") {
+  namespace fs = std::filesystem;
+  const std::string fname =
+      yodecon::testing::temp_name("compressed_test.con.gz");
+  const std::string frame = read_plain("test_data/cuh2.con");
+  constexpr size_t nframes{200};
+  // Two concatenated members, as written by `cat a.gz b.gz`
+  for (const char *mode : {"wb", "ab"}) {
+    gzFile out = gzopen(fname.c_str(), mode);
+    REQUIRE(out != nullptr);
+    for (size_t idx{0}; idx < nframes / 2; idx++) {
+      gzwrite(out, frame.data(), static_cast<unsigned>(frame.size()));
+    }
+    gzclose(out);
+  }
+  REQUIRE(fs::file_size(fname) < frame.size() * nframes / 2);
+
+  auto expected =
+      yodecon::create_single_con<yodecon::types::ConFrameVec>(frame);
+  yodecon::ConFrameStream<yodecon::types::ConFrameVec> frames{fname, 4096};
+  size_t count{0};
+  for (const auto &parsed : frames) {
+    REQUIRE(parsed.z == expected.z);
+    count++;
+  }
+  REQUIRE(count == nframes);
+  REQUIRE(frames.reader().consumed() == frame.size() * nframes);
+  REQUIRE(frames.reader().capacity() <= 2 * (frame.size() + 4096));
+  fs::remove(fname);
+}
+#endif
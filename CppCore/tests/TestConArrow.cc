@@ -0,0 +1,329 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <algorithm>
+#include <filesystem>
+
+#include "readCon/include/ConArrow.hpp"
+#include "readCon/include/ReadCon.hpp"
+
+#include "TestHelpers.hpp"
+
+#include "catch2/catch_amalgamated.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+using yodecon::testing::load_frames;
+using yodecon::testing::require_same;
+using yodecon::testing::temp_name;
+using yodecon::types::ConFrame;
+using yodecon::types::ConFrameVec;
+using yodecon::types::ConFrameVecFloat;
+} // namespace
+
+TEST_CASE("ConFrameVec columns move into Arrow buffers", "[ConArrow]") {
+  auto frame = load_frames<ConFrameVec>("test_data/cuh2.con").front();
+  const auto expected = frame;
+  const double *x_data = frame.x.data();
+  const int *id_data = frame.atom_id.data();
+
+  auto table = yodecon::conarrow::ConvertToArrowTable(std::move(frame));
+  REQUIRE(table->num_rows() == static_cast<int64_t>(expected.x.size()));
+  REQUIRE(table->num_columns() == 6);
+  REQUIRE(frame.x.empty());
+  REQUIRE(frame.symbol.empty());
+
+  auto x = std::static_pointer_cast<arrow::DoubleArray>(
+      table->GetColumnByName("x")->chunk(0));
+  auto z = std::static_pointer_cast<arrow::DoubleArray>(
+      table->GetColumnByName("z")->chunk(0));
+  auto ids = std::static_pointer_cast<arrow::Int32Array>(
+      table->GetColumnByName("atom_id")->chunk(0));
+  auto fixed = std::static_pointer_cast<arrow::BooleanArray>(
+      table->GetColumnByName("is_fixed")->chunk(0));
+  // The columns are the parsed vectors, not copies of them
+  REQUIRE(x->raw_values() == x_data);
+  REQUIRE(ids->raw_values() == id_data);
+  for (int64_t idx{0}; idx < table->num_rows(); idx++) {
+    const auto atm = static_cast<size_t>(idx);
+    REQUIRE(x->Value(idx) == expected.x[atm]);
+    REQUIRE(z->Value(idx) == expected.z[atm]);
+    REQUIRE(ids->Value(idx) == expected.atom_id[atm]);
+    REQUIRE(fixed->Value(idx) == expected.is_fixed[atm]);
+  }
+
+  auto symbols = std::static_pointer_cast<arrow::DictionaryArray>(
+      table->GetColumnByName("symbol")->chunk(0));
+  auto dictionary =
+      std::static_pointer_cast<arrow::StringArray>(symbols->dictionary());
+  REQUIRE(dictionary->length() == 2);
+  REQUIRE(dictionary->GetString(0) == "Cu");
+  REQUIRE(dictionary->GetString(1) == "H");
+  for (int64_t idx{0}; idx < table->num_rows(); idx++) {
+    REQUIRE(dictionary->GetString(symbols->GetValueIndex(idx)) ==
+            expected.symbol[static_cast<size_t>(idx)]);
+  }
+}
+
+TEST_CASE("Frame layouts share the Arrow metadata", "[ConArrow]") {
+  auto atoms = yodecon::conarrow::ConvertToArrowTable(
+      load_frames<ConFrame>("test_data/tiny_multi_cuh2.con").front());
+  auto vec = yodecon::conarrow::ConvertToArrowTable(
+      std::move(load_frames<ConFrameVec>("test_data/tiny_multi_cuh2.con")[0]));
+  REQUIRE(vec->schema()->metadata()->Equals(*atoms->schema()->metadata()));
+  REQUIRE(vec->schema()->metadata()->Get("natms_per_type").ValueOrDie() ==
+          "2,2");
+
+  auto floats = load_frames<ConFrameVecFloat>("test_data/tiny_multi_cuh2.con");
+  auto single = yodecon::conarrow::ConvertToArrowTable(std::move(floats[0]));
+  REQUIRE(single->GetColumnByName("y")->type()->Equals(arrow::float32()));
+  REQUIRE(single->num_rows() == 4);
+}
+
+TEST_CASE("Ragged ConFrameVec columns are rejected", "[ConArrow]") {
+  auto frame = load_frames<ConFrameVec>("test_data/sulfolene.con").front();
+  frame.is_fixed.pop_back();
+  REQUIRE_THROWS_AS(yodecon::conarrow::ConvertToArrowTable(std::move(frame)),
+                    std::invalid_argument);
+}
+
+TEST_CASE("Trajectories convert to one chunk per frame", "[ConArrow]") {
+  auto frames = load_frames<ConFrameVec>("test_data/tiny_multi_cuh2.con");
+  // Frames need not share their symbols
+  std::fill(frames[1].symbol.begin() + 2, frames[1].symbol.end(), "He");
+  frames[1].masses_per_type[1] = 4.002602;
+  frames[1].postbox_header[1] = "Second frame";
+  const auto expected = frames;
+
+  yodecon::helpers::parallel::ThreadPool pool{2};
+  auto tables =
+      yodecon::conarrow::ConvertTrajectoryToArrow(std::move(frames), pool);
+  REQUIRE(tables.atoms->num_rows() == 8);
+  REQUIRE(tables.atoms->schema()->field(0)->name() == "frame");
+  for (const auto &column : tables.atoms->columns()) {
+    REQUIRE(column->num_chunks() == 2);
+  }
+
+  for (int idx{0}; idx < 2; idx++) {
+    const auto &frame = expected[static_cast<size_t>(idx)];
+    auto batch =
+        yodecon::conarrow::get_chunk_as_record_batch(tables.atoms, idx);
+    REQUIRE(batch->num_rows() == 4);
+    auto index = std::static_pointer_cast<arrow::Int64Array>(
+        batch->GetColumnByName("frame"));
+    auto y = std::static_pointer_cast<arrow::DoubleArray>(
+        batch->GetColumnByName("y"));
+    auto symbols = std::static_pointer_cast<arrow::DictionaryArray>(
+        batch->GetColumnByName("symbol"));
+    auto dictionary =
+        std::static_pointer_cast<arrow::StringArray>(symbols->dictionary());
+    REQUIRE(dictionary->length() == 3);
+    for (int64_t atm{0}; atm < batch->num_rows(); atm++) {
+      REQUIRE(index->Value(atm) == idx);
+      REQUIRE(y->Value(atm) == frame.y[static_cast<size_t>(atm)]);
+      REQUIRE(dictionary->GetString(symbols->GetValueIndex(atm)) ==
+              frame.symbol[static_cast<size_t>(atm)]);
+    }
+  }
+
+  REQUIRE(tables.cells->num_rows() == 2);
+  auto natoms = std::static_pointer_cast<arrow::Int64Array>(
+      tables.cells->GetColumnByName("natoms")->chunk(0));
+  auto a = std::static_pointer_cast<arrow::DoubleArray>(
+      tables.cells->GetColumnByName("a")->chunk(0));
+  auto gamma = std::static_pointer_cast<arrow::DoubleArray>(
+      tables.cells->GetColumnByName("gamma")->chunk(0));
+  auto natm_types = std::static_pointer_cast<arrow::Int64Array>(
+      tables.cells->GetColumnByName("natm_types")->chunk(0));
+  auto natms_per_type = std::static_pointer_cast<arrow::ListArray>(
+      tables.cells->GetColumnByName("natms_per_type")->chunk(0));
+  auto masses_per_type = std::static_pointer_cast<arrow::ListArray>(
+      tables.cells->GetColumnByName("masses_per_type")->chunk(0));
+  auto postbox = std::static_pointer_cast<arrow::ListArray>(
+      tables.cells->GetColumnByName("postbox_header")->chunk(0));
+  for (int64_t idx{0}; idx < 2; idx++) {
+    const auto &frame = expected[static_cast<size_t>(idx)];
+    REQUIRE(natoms->Value(idx) == 4);
+    REQUIRE(a->Value(idx) == frame.boxl[0]);
+    REQUIRE(gamma->Value(idx) == frame.angles[2]);
+    REQUIRE(natm_types->Value(idx) == 2);
+    auto counts = std::static_pointer_cast<arrow::UInt64Array>(
+        natms_per_type->value_slice(idx));
+    auto masses = std::static_pointer_cast<arrow::DoubleArray>(
+        masses_per_type->value_slice(idx));
+    auto lines =
+        std::static_pointer_cast<arrow::StringArray>(postbox->value_slice(idx));
+    REQUIRE(counts->length() == 2);
+    REQUIRE(lines->length() == 2);
+    for (int64_t type{0}; type < 2; type++) {
+      const auto pos = static_cast<size_t>(type);
+      REQUIRE(counts->Value(type) == frame.natms_per_type[pos]);
+      REQUIRE(masses->Value(type) == frame.masses_per_type[pos]);
+      REQUIRE(lines->GetString(type) == frame.postbox_header[pos]);
+    }
+  }
+}
+
+TEST_CASE("Trajectory conversion handles edge cases", "[ConArrow]") {
+  auto empty = yodecon::conarrow::ConvertTrajectoryToArrow(
+      std::vector<yodecon::types::ConFrameVecFloat>{}, 1);
+  REQUIRE(empty.atoms->num_rows() == 0);
+  REQUIRE(empty.atoms->num_columns() == 7);
+  REQUIRE(
+      empty.atoms->GetColumnByName("x")->type()->Equals(arrow::float32()));
+  REQUIRE(empty.cells->num_rows() == 0);
+
+  std::vector<yodecon::types::ConFrameVec> frames{
+      load_frames<ConFrameVec>("test_data/sulfolene.con").front(),
+      load_frames<ConFrameVec>("test_data/cuh2.con").front()};
+  frames[1].atom_id.pop_back();
+  REQUIRE_THROWS_AS(
+      yodecon::conarrow::ConvertTrajectoryToArrow(std::move(frames), 2),
+      std::invalid_argument);
+}
+
+TEST_CASE("Frames round trip through Arrow IPC files", "[ConArrow]") {
+  auto frame = load_frames<ConFrameVec>("test_data/cuh2.con").front();
+  frame.boxl[0] = 15.345612345678901;
+  const auto expected = frame;
+  const auto table =
+      yodecon::conarrow::ConvertToArrowTable(std::move(frame));
+  const std::string fname = temp_name("arrow_frame.arrow");
+  yodecon::conarrow::write_ipc(fname, *table);
+
+  const auto cached = yodecon::conarrow::read_ipc(fname);
+  REQUIRE(cached->schema()->Equals(*table->schema(), true));
+  REQUIRE(cached->num_rows() == table->num_rows());
+  yodecon::conarrow::ArrowFrameView view{
+      yodecon::conarrow::get_chunk_as_record_batch(cached, 0)};
+  REQUIRE(view.natoms() == expected.x.size());
+  REQUIRE(view.boxl() == expected.boxl);
+  REQUIRE(view.angles() == expected.angles);
+  REQUIRE(view.prebox_header() == expected.prebox_header);
+  REQUIRE(view.postbox_header() == expected.postbox_header);
+  REQUIRE(view.natms_per_type() == expected.natms_per_type);
+  REQUIRE(view.masses_per_type() == expected.masses_per_type);
+  REQUIRE(view.symbol(0) == "Cu");
+  REQUIRE(view.symbol(view.natoms() - 1) == "H");
+
+  // The columns are the mapped file, not copies of it
+  auto x = std::static_pointer_cast<arrow::DoubleArray>(
+      cached->GetColumnByName("x")->chunk(0));
+  REQUIRE(view.x().data() == x->raw_values());
+  REQUIRE_FALSE(x->data()->buffers[1]->is_mutable());
+  for (size_t idx{0}; idx < view.natoms(); idx++) {
+    REQUIRE(view.x()[idx] == expected.x[idx]);
+    REQUIRE(view.z()[idx] == expected.z[idx]);
+    REQUIRE(view.atom_id()[idx] == expected.atom_id[idx]);
+    REQUIRE(view.is_fixed(idx) == expected.is_fixed[idx]);
+  }
+
+  const auto copy = view.to_frame();
+  REQUIRE(copy.natm_types == expected.natm_types);
+  REQUIRE(copy.symbol == expected.symbol);
+  REQUIRE(copy.y == expected.y);
+  REQUIRE(copy.is_fixed == expected.is_fixed);
+  REQUIRE(copy.atom_id == expected.atom_id);
+  fs::remove(fname);
+}
+
+TEST_CASE("Trajectories keep their chunks in Arrow IPC files", "[ConArrow]") {
+  auto frames = load_frames<ConFrameVec>("test_data/tiny_multi_cuh2.con");
+  frames.push_back(
+      load_frames<ConFrameVec>("test_data/sulfolene.con").front());
+  frames[1].boxl[2] = 0.1 + 0.2;
+  frames[1].prebox_header[0] = "Second, with a comma";
+  const auto expected = frames;
+  auto tables = yodecon::conarrow::ConvertTrajectoryToArrow(std::move(frames));
+  const std::string atoms = temp_name("arrow_atoms.arrow");
+  const std::string cells = temp_name("arrow_cells.arrow");
+  yodecon::conarrow::write_ipc(atoms, *tables.atoms);
+  yodecon::conarrow::write_ipc(cells, *tables.cells);
+
+  const auto cached = yodecon::conarrow::read_ipc(atoms);
+  REQUIRE(cached->Equals(*tables.atoms));
+  REQUIRE(cached->column(0)->num_chunks() == 3);
+  auto batch = yodecon::conarrow::get_chunk_as_record_batch(cached, 1);
+  auto z = std::static_pointer_cast<arrow::DoubleArray>(
+      batch->GetColumnByName("z"));
+  for (int64_t atm{0}; atm < batch->num_rows(); atm++) {
+    REQUIRE(z->Value(atm) == expected[1].z[static_cast<size_t>(atm)]);
+  }
+  const auto cached_cells = yodecon::conarrow::read_ipc(cells);
+  REQUIRE(cached_cells->Equals(*tables.cells));
+
+  // Each chunk reads back as its frame, the header coming from the cells
+  for (int idx{0}; idx < 3; idx++) {
+    yodecon::conarrow::ArrowFrameView view{
+        yodecon::conarrow::get_chunk_as_record_batch(cached, idx),
+        *cached_cells, idx};
+    require_same(view.to_frame(), expected[static_cast<size_t>(idx)]);
+  }
+  REQUIRE_THROWS_AS(
+      yodecon::conarrow::ArrowFrameView(batch, *cached_cells, 3),
+      std::out_of_range);
+  // A chunk and a cells row of different frames
+  REQUIRE_THROWS_AS(
+      yodecon::conarrow::ArrowFrameView(
+          yodecon::conarrow::get_chunk_as_record_batch(cached, 0),
+          *cached_cells, 1),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(
+      yodecon::conarrow::ArrowFrameView(batch, *cached_cells, 2),
+      std::invalid_argument);
+  fs::remove(atoms);
+  fs::remove(cells);
+}
+
+TEST_CASE("Single precision frames round trip through Arrow IPC files",
+          "[ConArrow]") {
+  auto frames = load_frames<ConFrameVecFloat>("test_data/tiny_multi_cuh2.con");
+  const auto expected = frames;
+  auto single = frames[0];
+  auto tables = yodecon::conarrow::ConvertTrajectoryToArrow(std::move(frames));
+  const std::string atoms = temp_name("arrow_float_atoms.arrow");
+  const std::string cells = temp_name("arrow_float_cells.arrow");
+  const std::string frame = temp_name("arrow_float_frame.arrow");
+  yodecon::conarrow::write_ipc(atoms, *tables.atoms);
+  yodecon::conarrow::write_ipc(cells, *tables.cells);
+  yodecon::conarrow::write_ipc(
+      frame, *yodecon::conarrow::ConvertToArrowTable(std::move(single)));
+
+  const auto cached = yodecon::conarrow::read_ipc(atoms);
+  const auto cached_cells = yodecon::conarrow::read_ipc(cells);
+  for (int idx{0}; idx < 2; idx++) {
+    const auto batch =
+        yodecon::conarrow::get_chunk_as_record_batch(cached, idx);
+    yodecon::conarrow::ArrowFrameViewFloat view{batch, *cached_cells, idx};
+    require_same(view.to_frame(), expected[static_cast<size_t>(idx)]);
+    // Asking for the other precision names the right view
+    REQUIRE_THROWS_WITH(
+        yodecon::conarrow::ArrowFrameView(batch, *cached_cells, idx),
+        Catch::Matchers::ContainsSubstring("ArrowFrameViewFloat"));
+  }
+  yodecon::conarrow::ArrowFrameViewFloat view{
+      yodecon::conarrow::get_chunk_as_record_batch(
+          yodecon::conarrow::read_ipc(frame), 0)};
+  require_same(view.to_frame(), expected[0]);
+  fs::remove(atoms);
+  fs::remove(cells);
+  fs::remove(frame);
+}
+
+TEST_CASE("Unsuitable Arrow IPC input is rejected", "[ConArrow]") {
+  REQUIRE_THROWS_AS(
+      yodecon::conarrow::read_ipc("test_data/tiny_multi_cuh2.con"),
+      std::runtime_error);
+  REQUIRE_THROWS_AS(
+      yodecon::conarrow::read_ipc(temp_name("arrow_missing.arrow")),
+      std::runtime_error);
+
+  // The ConFrame layout stores symbols as plain strings
+  auto table = yodecon::conarrow::ConvertToArrowTable(
+      load_frames<ConFrame>("test_data/sulfolene.con").front());
+  REQUIRE(table->GetColumnByName("symbol")->type()->Equals(*arrow::utf8()));
+  REQUIRE(table->GetColumnByName("atom_id")->type()->Equals(*arrow::uint64()));
+  const auto batch = yodecon::conarrow::get_chunk_as_record_batch(table, 0);
+  REQUIRE_THROWS_WITH(yodecon::conarrow::ArrowFrameView{batch},
+                      Catch::Matchers::ContainsSubstring("ConFrame overload"));
+}
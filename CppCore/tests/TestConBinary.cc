@@ -0,0 +1,157 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <filesystem>
+#include <fstream>
+
+#include "readCon/include/ConBinary.hpp"
+#include "readCon/include/ReadCon.hpp"
+
+#include "TestHelpers.hpp"
+
+#include "catch2/catch_amalgamated.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+using yodecon::types::ConFrameVec;
+using yodecon::testing::load_frames;
+using yodecon::testing::require_same;
+using yodecon::testing::temp_name;
+} // namespace
+
+TEST_CASE("Binary trajectories round trip losslessly", "[ConBinary]") {
+  for (const std::string stem : {"tiny_multi_cuh2", "cuh2", "sulfolene"}) {
+    DYNAMIC_SECTION(stem) {
+      const auto frames =
+          load_frames<ConFrameVec>("test_data/" + stem + ".con");
+      const std::string fname = temp_name("conb_" + stem + ".conb");
+      yodecon::conb::write_conb(fname, frames);
+
+      yodecon::conb::ConbReader traj{fname};
+      REQUIRE(traj.size() == frames.size());
+      auto copies = traj.read_all();
+      REQUIRE(copies.size() == frames.size());
+      for (size_t idx{0}; idx < frames.size(); idx++) {
+        require_same(copies[idx], frames[idx]);
+      }
+      REQUIRE_THROWS_AS(traj.read_frame(traj.size()), std::out_of_range);
+      fs::remove(fname);
+    }
+  }
+}
+
+TEST_CASE("Binary frames are viewed in place", "[ConBinary]") {
+  const auto frames = load_frames<ConFrameVec>("test_data/tiny_multi_cuh2.con");
+  const std::string fname = temp_name("conb_views.conb");
+  yodecon::conb::write_conb(fname, frames);
+  yodecon::conb::ConbReader traj{fname};
+  for (size_t idx{0}; idx < traj.size(); idx++) {
+    const auto &expected = frames[idx];
+    auto view = traj.frame(idx);
+    REQUIRE(view.natoms() == expected.x.size());
+    REQUIRE(view.natm_types() == expected.natm_types);
+    REQUIRE(view.boxl() == expected.boxl);
+    REQUIRE(view.prebox_header()[0] == expected.prebox_header[0]);
+    REQUIRE(view.postbox_header()[1] == expected.postbox_header[1]);
+    REQUIRE(view.type_symbols() ==
+            std::vector<std::string_view>{"Cu", "H"});
+    REQUIRE(std::vector<double>(view.x().begin(), view.x().end()) ==
+            expected.x);
+    REQUIRE(std::vector<double>(view.masses_per_type().begin(),
+                                view.masses_per_type().end()) ==
+            expected.masses_per_type);
+    for (size_t atm{0}; atm < view.natoms(); atm++) {
+      REQUIRE(view.z()[atm] == expected.z[atm]);
+      REQUIRE(view.atom_id()[atm] == expected.atom_id[atm]);
+      REQUIRE((view.is_fixed()[atm] != 0) == expected.is_fixed[atm]);
+    }
+    // Columns are aligned in the mapping, so they can be used as arrays
+    REQUIRE(reinterpret_cast<uintptr_t>(view.y().data()) % alignof(double) ==
+            0);
+  }
+  REQUIRE_THROWS_AS(traj.frame(traj.size()), std::out_of_range);
+  fs::remove(fname);
+}
+
+TEST_CASE("Text trajectories convert to binary", "[ConBinary]") {
+  const auto frames = load_frames<ConFrameVec>("test_data/tiny_multi_cuh2.con");
+  const std::string fname = temp_name("conb_converted.conb");
+  REQUIRE(yodecon::conb::convert_to_conb("test_data/tiny_multi_cuh2.con",
+                                         fname) == frames.size());
+  yodecon::conb::ConbReader traj{fname};
+  REQUIRE(traj.size() == frames.size());
+  require_same(traj.read_frame(1), frames[1]);
+  fs::remove(fname);
+
+  // Empty trajectories are valid
+  yodecon::conb::write_conb(fname, {});
+  REQUIRE(yodecon::conb::ConbReader{fname}.empty());
+  fs::remove(fname);
+}
+
+TEST_CASE("Failed conversions leave no binary file", "[ConBinary]") {
+  const std::string plain =
+      yodecon::testing::read_plain("test_data/tiny_multi_cuh2.con");
+  // Without the last atom line
+  const std::string con = temp_name("truncated.con");
+  {
+    std::ofstream ofs{con, std::ios::binary | std::ios::trunc};
+    ofs << plain.substr(0, plain.rfind('\n', plain.size() - 2) + 1);
+  }
+  const std::string fname = temp_name("conb_interrupted.conb");
+  REQUIRE_THROWS_AS(yodecon::conb::convert_to_conb(con, fname),
+                    std::invalid_argument);
+  REQUIRE_FALSE(fs::exists(fname));
+
+  const auto frames = load_frames<ConFrameVec>("test_data/tiny_multi_cuh2.con");
+  const auto interrupted = [&] {
+    yodecon::conb::ConbWriter out{fname};
+    out.write(frames[0]);
+    throw std::runtime_error("conversion interrupted");
+  };
+  REQUIRE_THROWS_AS(interrupted(), std::runtime_error);
+  REQUIRE_FALSE(fs::exists(fname));
+  fs::remove(con);
+}
+
+TEST_CASE("Malformed binary trajectories are rejected", "[ConBinary]") {
+  REQUIRE_THROWS_AS(
+      yodecon::conb::ConbReader{"test_data/tiny_multi_cuh2.con"},
+      std::invalid_argument);
+
+  auto frame = load_frames<ConFrameVec>("test_data/tiny_multi_cuh2.con")[0];
+  std::string out;
+  frame.symbol[1] = "Ag";
+  REQUIRE_THROWS_AS(yodecon::conb::encode_frame(frame, out),
+                    std::invalid_argument);
+  frame.symbol[1] = "Cu";
+  frame.z.pop_back();
+  REQUIRE_THROWS_AS(yodecon::conb::encode_frame(frame, out),
+                    std::invalid_argument);
+  frame.z.push_back(0);
+  yodecon::conb::encode_frame(frame, out);
+  REQUIRE(out.size() % yodecon::conb::Alignment == 0);
+  REQUIRE_THROWS_AS(
+      yodecon::conb::FrameView{std::string_view{out}.substr(0, 100)},
+      std::invalid_argument);
+
+  // Counts which only add up to natoms after wrapping around
+  std::string wrapped = out;
+  const size_t counts =
+      reinterpret_cast<const char *>(
+          yodecon::conb::FrameView{wrapped}.natms_per_type().data()) -
+      wrapped.data();
+  for (size_t byte{0}; byte < 8; byte++) {
+    wrapped[counts + byte] = static_cast<char>(0xff);
+    wrapped[counts + 8 + byte] = static_cast<char>(byte == 0 ? 5 : 0);
+  }
+  REQUIRE_THROWS_AS(yodecon::conb::FrameView{wrapped}, std::invalid_argument);
+
+  // Cut before the frame table
+  const std::string fname = temp_name("conb_truncated.conb");
+  yodecon::conb::write_conb(fname, {frame});
+  const auto size = fs::file_size(fname);
+  fs::resize_file(fname, size - yodecon::conb::TableEntrySize);
+  REQUIRE_THROWS_AS(yodecon::conb::ConbReader{fname}, std::invalid_argument);
+  fs::remove(fname);
+}
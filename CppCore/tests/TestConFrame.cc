@@ -416,3 +416,42 @@ TEST_CASE("ConFrameTest CreateMultiCon") {
     REQUIRE(result.atom_data[3].atom_id == 3);
   }
 }
+
+TEST_CASE("ConFrameTest - Filtered parse", "[ConFrame]") {
+  yodecon::helpers::file::MappedFile mapped{"test_data/sulfolene.con"};
+  auto full =
+      yodecon::create_single_con<yodecon::types::ConFrame>(mapped.view());
+
+  yodecon::ParseOptions opts;
+  opts.symbols = {"S", "O"};
+  auto result =
+      yodecon::create_single_con<yodecon::types::ConFrame>(mapped.view(), opts);
+  REQUIRE(result.natm_types == 2);
+  REQUIRE(result.natms_per_type == std::vector<size_t>{2, 1});
+  REQUIRE(result.masses_per_type.size() == 2);
+  REQUIRE_THAT(result.masses_per_type[1],
+               Catch::Matchers::WithinAbs(32.065, fp_tol));
+  REQUIRE(result.atom_data.size() == 3);
+  REQUIRE(result.atom_data[0].symbol == "O");
+  REQUIRE(result.atom_data[1].x == full.atom_data[1].x);
+  REQUIRE(result.atom_data[2].symbol == "S");
+  REQUIRE(result.atom_data[2].atom_id == 13);
+  REQUIRE(result.atom_data[2].z == full.atom_data[12].z);
+
+  yodecon::ParseOptions ids;
+  ids.atom_ids = std::make_pair(5, 8);
+  result =
+      yodecon::create_single_con<yodecon::types::ConFrame>(mapped.view(), ids);
+  REQUIRE(result.natms_per_type == std::vector<size_t>{2, 2});
+  REQUIRE(result.atom_data.size() == 4);
+  REQUIRE(result.atom_data[0].symbol == "C");
+  REQUIRE(result.atom_data[0].atom_id == 5);
+  REQUIRE(result.atom_data[3].symbol == "H");
+  REQUIRE(result.atom_data[3].y == full.atom_data[7].y);
+
+  ids.symbols = {"Cu"};
+  result =
+      yodecon::create_single_con<yodecon::types::ConFrame>(mapped.view(), ids);
+  REQUIRE(result.natm_types == 0);
+  REQUIRE(result.atom_data.empty());
+}
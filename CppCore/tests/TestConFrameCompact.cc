@@ -0,0 +1,74 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include "readCon/include/ConFrameStream.hpp"
+#include "readCon/include/ReadCon.hpp"
+
+#include "catch2/catch_amalgamated.hpp"
+
+constexpr double fp_tol{1e-12};
+
+TEST_CASE("AtomDatumCompact is packed", "[ConFrameCompact]") {
+  REQUIRE(sizeof(yodecon::types::AtomDatumCompact) == 32);
+  REQUIRE(sizeof(yodecon::types::AtomDatumCompact) <
+          sizeof(yodecon::types::AtomDatum));
+  yodecon::types::AtomDatumCompact atom(6, 1.0, 2.0, 3.0, true, 123);
+  REQUIRE(atom.atomic_number == 6);
+  REQUIRE_THAT(atom.z, Catch::Matchers::WithinAbs(3.0, fp_tol));
+  REQUIRE(atom.is_fixed);
+  REQUIRE(atom.atom_id == 123);
+}
+
+TEST_CASE("ConFrameCompact parses like ConFrame", "[ConFrameCompact]") {
+  yodecon::helpers::file::MappedFile mapped{"test_data/sulfolene.con"};
+  auto expected =
+      yodecon::create_single_con<yodecon::types::ConFrame>(mapped.view());
+  auto result = yodecon::create_single_con<yodecon::types::ConFrameCompact>(
+      mapped.view());
+
+  REQUIRE(result.natm_types == 4);
+  REQUIRE(result.atom_data.size() == 13);
+  REQUIRE(result.atom_data[0].atomic_number == 8);
+  REQUIRE(result.atom_data[12].atomic_number == 16);
+  for (size_t atm{0}; atm < result.atom_data.size(); atm++) {
+    REQUIRE(result.atom_data[atm].x == expected.atom_data[atm].x);
+    REQUIRE(result.atom_data[atm].y == expected.atom_data[atm].y);
+    REQUIRE(result.atom_data[atm].z == expected.atom_data[atm].z);
+    REQUIRE(result.atom_data[atm].is_fixed ==
+            expected.atom_data[atm].is_fixed);
+    REQUIRE(result.atom_data[atm].atom_id == expected.atom_data[atm].atom_id);
+  }
+
+  auto lines =
+      yodecon::helpers::file::read_con_file("test_data/tiny_multi_cuh2.con");
+  auto from_lines =
+      yodecon::create_multi_con<yodecon::types::ConFrameCompact>(lines);
+  REQUIRE(from_lines.size() == 2);
+  REQUIRE(from_lines[1].atom_data[0].atomic_number == 29);
+  REQUIRE(from_lines[1].atom_data[3].atomic_number == 1);
+  REQUIRE_THAT(from_lines[1].atom_data[3].x,
+               Catch::Matchers::WithinAbs(7.76944285714285154, fp_tol));
+}
+
+TEST_CASE("ConFrameCompact conversions round trip", "[ConFrameCompact]") {
+  auto frames = yodecon::create_multi_con<yodecon::types::ConFrame>(
+      yodecon::helpers::file::read_con_file("test_data/tiny_multi_cuh2.con"));
+  for (const auto &frame : frames) {
+    auto compact = yodecon::to_compact(frame);
+    REQUIRE(compact.boxl == frame.boxl);
+    REQUIRE(compact.natms_per_type == frame.natms_per_type);
+    auto back = yodecon::from_compact(compact);
+    REQUIRE(back.prebox_header == frame.prebox_header);
+    REQUIRE(back.atom_data.size() == frame.atom_data.size());
+    for (size_t atm{0}; atm < back.atom_data.size(); atm++) {
+      REQUIRE(back.atom_data[atm].symbol == frame.atom_data[atm].symbol);
+      REQUIRE(back.atom_data[atm].x == frame.atom_data[atm].x);
+      REQUIRE(back.atom_data[atm].atom_id == frame.atom_data[atm].atom_id);
+    }
+  }
+
+  frames[0].atom_data[0].symbol = "Xx";
+  REQUIRE_THROWS_AS(yodecon::to_compact(frames[0]), std::invalid_argument);
+  auto compact = yodecon::to_compact(frames[1]);
+  compact.atom_data[0].atomic_number = 200;
+  REQUIRE_THROWS_AS(yodecon::from_compact(compact), std::invalid_argument);
+}
@@ -0,0 +1,91 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <charconv>
+
+#include "readCon/include/ConFrameStream.hpp"
+#include "readCon/include/ReadCon.hpp"
+
+#include "catch2/catch_amalgamated.hpp"
+
+TEST_CASE("Single precision frames halve the coordinates", "[ConFrameFloat]") {
+  REQUIRE(sizeof(yodecon::types::AtomDatumFloat::real_type) * 2 ==
+          sizeof(yodecon::types::AtomDatum::real_type));
+  REQUIRE(sizeof(yodecon::types::AtomDatumFloat) <
+          sizeof(yodecon::types::AtomDatum));
+  yodecon::types::AtomDatumFloat atom("C", 1.5F, 2.0F, 3.0F, true, 12);
+  REQUIRE(atom.x == 1.5F);
+  REQUIRE(atom.is_fixed);
+  REQUIRE(atom.atom_id == 12);
+}
+
+TEST_CASE("Float tokens are correctly rounded", "[ConFrameFloat]") {
+  // Rounds differently when going through a double first
+  const std::string_view token{"1.00000005960464477550"};
+  float direct{0};
+  std::from_chars(token.data(), token.data() + token.size(), direct);
+  float parsed{0};
+  REQUIRE(yodecon::helpers::string::parse_token(token, parsed));
+  REQUIRE(parsed == direct);
+  REQUIRE(parsed != static_cast<float>(1.00000005960464477550));
+  REQUIRE_FALSE(yodecon::helpers::string::parse_token("Cu", parsed));
+}
+
+TEST_CASE("Float frames parse like double frames", "[ConFrameFloat]") {
+  yodecon::helpers::file::MappedFile mapped{"test_data/sulfolene.con"};
+  auto expected =
+      yodecon::create_single_con<yodecon::types::ConFrameVec>(mapped.view());
+  auto vec = yodecon::create_single_con<yodecon::types::ConFrameVecFloat>(
+      mapped.view());
+  auto aos = yodecon::create_single_con<yodecon::types::ConFrameFloat>(
+      mapped.view());
+
+  REQUIRE(vec.boxl == expected.boxl);
+  REQUIRE(vec.masses_per_type == expected.masses_per_type);
+  REQUIRE(vec.symbol == expected.symbol);
+  REQUIRE(vec.is_fixed == expected.is_fixed);
+  REQUIRE(vec.atom_id == expected.atom_id);
+  REQUIRE(aos.atom_data.size() == 13);
+  for (size_t atm{0}; atm < expected.x.size(); atm++) {
+    REQUIRE_THAT(vec.x[atm], Catch::Matchers::WithinULP(
+                                 static_cast<float>(expected.x[atm]), 1));
+    REQUIRE_THAT(vec.z[atm], Catch::Matchers::WithinULP(
+                                 static_cast<float>(expected.z[atm]), 1));
+    REQUIRE(aos.atom_data[atm].x == vec.x[atm]);
+    REQUIRE(aos.atom_data[atm].y == vec.y[atm]);
+    REQUIRE(aos.atom_data[atm].symbol == expected.symbol[atm]);
+    REQUIRE(aos.atom_data[atm].atom_id == expected.atom_id[atm]);
+  }
+}
+
+TEST_CASE("Float frames through every entry point", "[ConFrameFloat]") {
+  auto lines =
+      yodecon::helpers::file::read_con_file("test_data/tiny_multi_cuh2.con");
+  auto from_lines =
+      yodecon::create_multi_con<yodecon::types::ConFrameVecFloat>(lines);
+  REQUIRE(from_lines.size() == 2);
+  REQUIRE_THAT(from_lines[1].x[3],
+               Catch::Matchers::WithinULP(7.76944285714285154F, 1));
+
+  yodecon::ConFrameStream<yodecon::types::ConFrameFloat> stream{
+      "test_data/tiny_multi_cuh2.con"};
+  size_t nframes{0};
+  for (const auto &frame : stream) {
+    REQUIRE(frame.atom_data[3].x == from_lines[nframes].x[3]);
+    nframes++;
+  }
+  REQUIRE(nframes == 2);
+
+  yodecon::helpers::file::MappedFile mapped{"test_data/tiny_multi_cuh2.con"};
+  yodecon::ParseOptions opts;
+  opts.symbols = {"H"};
+  opts.columns = yodecon::columns::Positions;
+  auto filtered =
+      yodecon::create_multi_con<yodecon::types::ConFrameVecFloat>(
+          mapped.view(), opts);
+  REQUIRE(filtered[1].x.size() == 2);
+  REQUIRE(filtered[1].x[1] == from_lines[1].x[3]);
+  REQUIRE(filtered[1].atom_id.empty());
+  auto filtered_aos = yodecon::create_multi_con<yodecon::types::ConFrameFloat>(
+      mapped.view(), opts);
+  REQUIRE(filtered_aos[1].atom_data[1].z == from_lines[1].z[3]);
+}
@@ -57,3 +57,78 @@ TEST_CASE("AtomicNumberToSymbolTest - EmptyInput", "[AtomicNumberToSymbol]") {
   REQUIRE(yodecon::atomic_numbers_to_symbols(atomic_numbers) ==
           expected_symbols);
 }
+
+TEST_CASE("ParseToken - numeric formats", "[NumericScan]") {
+  double dval{0};
+  REQUIRE(yodecon::helpers::string::parse_token("+1.5", dval));
+  REQUIRE(dval == 1.5);
+  REQUIRE(yodecon::helpers::string::parse_token("-0.00009999999999977", dval));
+  REQUIRE(dval == -0.00009999999999977);
+  REQUIRE(yodecon::helpers::string::parse_token("1e-3", dval));
+  REQUIRE(dval == 1e-3);
+  REQUIRE_FALSE(yodecon::helpers::string::parse_token("Cu", dval));
+  REQUIRE_FALSE(yodecon::helpers::string::parse_token("1.5x", dval));
+
+  size_t uval{0};
+  REQUIRE(yodecon::helpers::string::parse_token("218", uval));
+  REQUIRE(uval == 218);
+  REQUIRE(yodecon::helpers::string::parse_token("3.0", uval));
+  REQUIRE(uval == 3);
+  REQUIRE_THROWS_AS(yodecon::helpers::string::parse_token("-2", uval),
+                    std::invalid_argument);
+
+  // Neither undefined casts nor a second sign
+  int ival{7};
+  REQUIRE_THROWS_AS(yodecon::helpers::string::parse_token("3e9", ival),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS(yodecon::helpers::string::parse_token("-3e9", ival),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS(yodecon::helpers::string::parse_token("1e30", uval),
+                    std::invalid_argument);
+  REQUIRE_FALSE(yodecon::helpers::string::parse_token("nan", uval));
+  REQUIRE_FALSE(yodecon::helpers::string::parse_token("inf", ival));
+  REQUIRE_FALSE(yodecon::helpers::string::parse_token("+-5", ival));
+  REQUIRE_FALSE(yodecon::helpers::string::parse_token("++5", ival));
+  REQUIRE_FALSE(yodecon::helpers::string::parse_token("+-5", dval));
+  REQUIRE(ival == 7);
+  REQUIRE(yodecon::helpers::string::parse_token("-2147483648.0", ival));
+  REQUIRE(ival == -2147483648);
+  REQUIRE(yodecon::helpers::string::parse_token("2147483647.5", ival));
+  REQUIRE(ival == 2147483647);
+  REQUIRE(yodecon::helpers::string::parse_token("1.8e19", uval));
+  REQUIRE(uval == 18000000000000000000ULL);
+}
+
+TEST_CASE("ScanNumbers - coordinate lines", "[NumericScan]") {
+  std::array<double, 5> vals{};
+  REQUIRE(yodecon::helpers::string::scan_numbers(
+              "   0.63940000000000108    0.90450000000000019    "
+              "6.97529999999999539 1    0",
+              vals) == 5);
+  REQUIRE(vals[0] == 0.63940000000000108);
+  REQUIRE(vals[2] == 6.97529999999999539);
+  REQUIRE(vals[3] == 1);
+  REQUIRE(vals[4] == 0);
+
+  // Non-numeric tokens are skipped, extra values are ignored
+  std::array<double, 3> box{};
+  REQUIRE(yodecon::helpers::string::scan_numbers("0.0000 TIME 1 2 3", box) ==
+          3);
+  REQUIRE(box == std::array<double, 3>{0.0, 1.0, 2.0});
+}
+
+TEST_CASE("GetArrayFromString - short lines are zero filled",
+          "[NumericScan]") {
+  auto vals = yodecon::helpers::string::get_array_from_string<double, 3>(
+      "15.345600\t21.702000");
+  REQUIRE(vals == std::array<double, 3>{15.3456, 21.702, 0.0});
+  REQUIRE_THROWS_AS(
+      (yodecon::helpers::string::get_array_from_string<double, 3>("")),
+      std::invalid_argument);
+}
+
+TEST_CASE("GetValFromString - limits the tokens considered", "[NumericScan]") {
+  auto vals =
+      yodecon::helpers::string::get_val_from_string<size_t>("2 4 6 1", 3);
+  REQUIRE(vals == std::vector<size_t>{2, 4, 6});
+}
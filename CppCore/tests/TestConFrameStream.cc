@@ -0,0 +1,140 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "readCon/include/ConFrameStream.hpp"
+
+#include "catch2/catch_amalgamated.hpp"
+
+namespace {
+std::string repeated_trajectory(size_t a_nreps) {
+  yodecon::helpers::file::MappedFile mapped{"test_data/tiny_multi_cuh2.con"};
+  std::string trajectory;
+  for (size_t rep{0}; rep < a_nreps; rep++) {
+    trajectory += mapped.view();
+  }
+  return trajectory;
+}
+} // namespace
+
+TEST_CASE("ConFrameStream matches create_multi_con", "[ConFrameStream]") {
+  auto lines =
+      yodecon::helpers::file::read_con_file("test_data/tiny_multi_cuh2.con");
+  auto expected = yodecon::create_multi_con<yodecon::types::ConFrame>(lines);
+
+  // A tiny chunk forces frames to straddle many reads
+  for (size_t chunk : {size_t{7}, size_t{64}, size_t{1} << 20}) {
+    yodecon::ConFrameStream<yodecon::types::ConFrame> stream{
+        "test_data/tiny_multi_cuh2.con", chunk};
+    size_t nframes{0};
+    for (const auto &frame : stream) {
+      REQUIRE(frame.atom_data.size() == expected[nframes].atom_data.size());
+      for (size_t atm{0}; atm < frame.atom_data.size(); atm++) {
+        REQUIRE(frame.atom_data[atm].x == expected[nframes].atom_data[atm].x);
+        REQUIRE(frame.atom_data[atm].symbol ==
+                expected[nframes].atom_data[atm].symbol);
+      }
+      nframes++;
+    }
+    REQUIRE(nframes == expected.size());
+  }
+}
+
+TEST_CASE("ConFrameStream memory is bounded by the frame size",
+          "[ConFrameStream]") {
+  const std::string trajectory = repeated_trajectory(500);
+  auto expected =
+      yodecon::create_multi_con<yodecon::types::ConFrameVec>(trajectory);
+  const size_t frame_bytes = yodecon::ConIndex{trajectory}.at(0).nbytes;
+
+  std::istringstream input{trajectory};
+  yodecon::ConFrameStream<yodecon::types::ConFrameVec> stream{input, 256};
+  size_t nframes{0};
+  for (auto it = stream.begin(); it != stream.end(); ++it) {
+    REQUIRE(it->x == expected[nframes].x);
+    REQUIRE(it->atom_id == expected[nframes].atom_id);
+    nframes++;
+  }
+  REQUIRE(nframes == 1000);
+  REQUIRE(stream.reader().consumed() == trajectory.size());
+  REQUIRE(stream.reader().capacity() <= 2 * (frame_bytes + 256));
+}
+
+TEST_CASE("ConFrameStream rejects truncated input", "[ConFrameStream]") {
+  std::string trajectory = repeated_trajectory(1);
+  // Drops the last atom line entirely
+  trajectory.resize(trajectory.size() - 100);
+  std::istringstream input{trajectory};
+  yodecon::ConFrameStream<yodecon::types::ConFrameVec> stream{input, 32};
+  yodecon::types::ConFrameVec frame;
+  REQUIRE(stream.next(frame));
+  REQUIRE_THROWS_AS(stream.next(frame), std::invalid_argument);
+}
+
+TEST_CASE("ConFrameStream on an empty or missing input", "[ConFrameStream]") {
+  std::istringstream input{""};
+  yodecon::ConFrameStream<yodecon::types::ConFrame> stream{input};
+  REQUIRE(stream.begin() == stream.end());
+  REQUIRE_THROWS_AS(
+      yodecon::ConFrameStream<yodecon::types::ConFrame>{"test_data/nope.con"},
+      std::runtime_error);
+}
+
+TEST_CASE("ConFrameFollower holds back partially written frames",
+          "[ConFrameFollower]") {
+  namespace fs = std::filesystem;
+  const std::string fname =
+      (fs::temp_directory_path() / "readcon_follow_test.con").string();
+  const std::string trajectory = repeated_trajectory(2);
+  const size_t frame_bytes = yodecon::ConIndex{trajectory}.at(0).nbytes;
+  auto expected =
+      yodecon::create_multi_con<yodecon::types::ConFrameVec>(trajectory);
+  std::ofstream ofs{fname, std::ios::binary | std::ios::trunc};
+  auto append = [&](size_t a_from, size_t a_to) {
+    ofs.write(trajectory.data() + a_from,
+              static_cast<std::streamsize>(a_to - a_from));
+    ofs.flush();
+  };
+
+  // One frame and a half, the cut falls partway through a line
+  append(0, frame_bytes + frame_bytes / 2 + 3);
+  yodecon::ConFrameFollower<yodecon::types::ConFrameVec> follow{fname, 0, 16};
+  auto frames = follow.poll();
+  REQUIRE(frames.size() == 1);
+  REQUIRE(frames[0].x == expected[0].x);
+  REQUIRE(follow.offset() == frame_bytes);
+  REQUIRE(follow.poll().empty());
+
+  // Completing it, along with most of the next one
+  append(frame_bytes + frame_bytes / 2 + 3, 3 * frame_bytes - 1);
+  frames = follow.poll();
+  REQUIRE(frames.size() == 1);
+  REQUIRE(frames[0].x == expected[1].x);
+  REQUIRE(frames[0].atom_id == expected[1].atom_id);
+  REQUIRE(follow.offset() == 2 * frame_bytes);
+
+  // A fresh follower resumes from the stored offset
+  append(3 * frame_bytes - 1, trajectory.size());
+  yodecon::ConFrameFollower<yodecon::types::ConFrameVec> resumed{
+      fname, follow.offset()};
+  frames = resumed.poll();
+  REQUIRE(frames.size() == 2);
+  REQUIRE(frames[1].z == expected[3].z);
+  REQUIRE(follow.poll().size() == 2);
+  REQUIRE(follow.offset() == trajectory.size());
+
+  // Restarting the job truncates the file
+  ofs.close();
+  ofs.open(fname, std::ios::binary | std::ios::trunc);
+  append(0, frame_bytes);
+  REQUIRE_THROWS_AS(follow.poll(), std::runtime_error);
+  REQUIRE_THROWS_AS((yodecon::ConFrameFollower<yodecon::types::ConFrameVec>{
+                        fname, trajectory.size()}),
+                    std::runtime_error);
+  ofs.close();
+  fs::remove(fname);
+}
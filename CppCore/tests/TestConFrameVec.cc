@@ -207,3 +207,123 @@ TEST_CASE("ConFrameVecTest - CreateSingleCon_MultiFile", "[ConFrameVec]") {
   REQUIRE(result.is_fixed[3] == false);
   REQUIRE(result.atom_id[3] == 3);
 }
+
+TEST_CASE("ConFrameVecTest - Column selection", "[ConFrameVec]") {
+  yodecon::helpers::file::MappedFile mapped{"test_data/tiny_multi_cuh2.con"};
+  auto full =
+      yodecon::create_multi_con<yodecon::types::ConFrameVec>(mapped.view());
+
+  yodecon::ParseOptions positions;
+  positions.columns = yodecon::columns::Positions;
+  auto frames = yodecon::create_multi_con<yodecon::types::ConFrameVec>(
+      mapped.view(), positions);
+  REQUIRE(frames.size() == 2);
+  for (size_t frm{0}; frm < frames.size(); frm++) {
+    REQUIRE(frames[frm].natms_per_type == full[frm].natms_per_type);
+    REQUIRE(frames[frm].x == full[frm].x);
+    REQUIRE(frames[frm].y == full[frm].y);
+    REQUIRE(frames[frm].z == full[frm].z);
+    REQUIRE(frames[frm].symbol.empty());
+    REQUIRE(frames[frm].is_fixed.empty());
+    REQUIRE(frames[frm].atom_id.empty());
+  }
+
+  yodecon::ParseOptions ids;
+  ids.columns = yodecon::columns::AtomId | yodecon::columns::Symbol;
+  auto id_frame = yodecon::create_single_con<yodecon::types::ConFrameVec>(
+      mapped.view(), ids);
+  REQUIRE(id_frame.atom_id == full[0].atom_id);
+  REQUIRE(id_frame.symbol == full[0].symbol);
+  REQUIRE(id_frame.x.empty());
+
+  yodecon::ParseOptions symbols;
+  symbols.columns = yodecon::columns::Symbol;
+  auto sym_frames = yodecon::create_multi_con<yodecon::types::ConFrameVec>(
+      mapped.view(), symbols);
+  REQUIRE(sym_frames.size() == 2);
+  REQUIRE(sym_frames[1].symbol == full[1].symbol);
+
+  yodecon::ParseOptions all;
+  auto all_frame = yodecon::create_single_con<yodecon::types::ConFrameVec>(
+      mapped.view(), all);
+  REQUIRE(all_frame.is_fixed == full[0].is_fixed);
+  REQUIRE(all_frame.x == full[0].x);
+}
+
+TEST_CASE("ConFrameVecTest - Filtered parse", "[ConFrameVec]") {
+  yodecon::helpers::file::MappedFile mapped{"test_data/tiny_multi_cuh2.con"};
+  auto full =
+      yodecon::create_multi_con<yodecon::types::ConFrameVec>(mapped.view());
+
+  yodecon::ParseOptions opts;
+  opts.symbols = {"H"};
+  opts.columns = yodecon::columns::Positions | yodecon::columns::AtomId;
+  auto frames = yodecon::create_multi_con<yodecon::types::ConFrameVec>(
+      mapped.view(), opts);
+  REQUIRE(frames.size() == 2);
+  for (size_t frm{0}; frm < frames.size(); frm++) {
+    REQUIRE(frames[frm].natm_types == 1);
+    REQUIRE(frames[frm].natms_per_type == std::vector<size_t>{2});
+    REQUIRE(frames[frm].atom_id == std::vector<int>{2, 3});
+    REQUIRE(frames[frm].x ==
+            std::vector<double>{full[frm].x[2], full[frm].x[3]});
+    REQUIRE(frames[frm].symbol.empty());
+    REQUIRE(frames[frm].is_fixed.empty());
+  }
+
+  yodecon::ParseOptions ids;
+  ids.atom_ids = std::make_pair(1, 2);
+  auto frame = yodecon::create_single_con<yodecon::types::ConFrameVec>(
+      mapped.view(), ids);
+  REQUIRE(frame.natms_per_type == std::vector<size_t>{1, 1});
+  REQUIRE(frame.symbol == std::vector<std::string>{"Cu", "H"});
+  REQUIRE(frame.atom_id == std::vector<int>{1, 2});
+  REQUIRE(frame.is_fixed == std::vector<bool>{true, false});
+  REQUIRE(frame.z == std::vector<double>{full[0].z[1], full[0].z[2]});
+}
+
+TEST_CASE("ConFrameVecTest - Parser policies", "[ConFrameVec]") {
+  using yodecon::types::ConFrameVec;
+  yodecon::helpers::file::MappedFile mapped{"test_data/tiny_multi_cuh2.con"};
+  auto lenient = yodecon::create_multi_con<ConFrameVec>(mapped.view());
+  auto strict = yodecon::create_multi_con<ConFrameVec, yodecon::policy::Strict>(
+      mapped.view());
+  auto trusted =
+      yodecon::create_multi_con<ConFrameVec, yodecon::policy::Trusted>(
+          mapped.view());
+  REQUIRE(strict.size() == 2);
+  REQUIRE(trusted.size() == 2);
+  for (size_t frm{0}; frm < lenient.size(); frm++) {
+    REQUIRE(strict[frm].x == lenient[frm].x);
+    REQUIRE(strict[frm].is_fixed == lenient[frm].is_fixed);
+    REQUIRE(strict[frm].atom_id == lenient[frm].atom_id);
+    REQUIRE(trusted[frm].y == lenient[frm].y);
+    REQUIRE(trusted[frm].z == lenient[frm].z);
+    REQUIRE(trusted[frm].is_fixed == lenient[frm].is_fixed);
+    REQUIRE(trusted[frm].atom_id == lenient[frm].atom_id);
+  }
+  auto compact = yodecon::create_single_con<yodecon::types::ConFrameCompact,
+                                            yodecon::policy::Strict>(
+      mapped.view());
+  REQUIRE(compact.atom_data[3].x == lenient[0].x[3]);
+
+  // Lenient skips what Strict rejects
+  const std::string header{"\n\n10 10 10\n90 90 90\n\n\n1\n1\n1.008\nH\n"
+                           "Coordinates of Component 1\n"};
+  auto parse_strict = [](const std::string &a_text) {
+    return yodecon::create_single_con<ConFrameVec, yodecon::policy::Strict>(
+        a_text);
+  };
+  const std::string skipped{header + "1.0 x 2.0 3.0 0 7\n"};
+  REQUIRE(yodecon::create_single_con<ConFrameVec>(skipped).y[0] == 2.0);
+  REQUIRE_THROWS_AS(parse_strict(skipped), std::invalid_argument);
+  REQUIRE_THROWS_AS(parse_strict(header + "1.0 2.0 3.0 0\n"),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS(parse_strict(header + "1.0 2.0 3.0 0 7 8\n"),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS(parse_strict(header + "1.0 2.0 3.0 2 7\n"),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS(parse_strict(header + "1.0 2.0 3.0 0 7.5\n"),
+                    std::invalid_argument);
+  REQUIRE(parse_strict(header + "1.0 2.0 3.0 1 7\n").atom_id[0] == 7);
+}
@@ -0,0 +1,52 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include "readCon/include/ConFrameStream.hpp"
+#include "readCon/include/ReadCon.hpp"
+
+#include "catch2/catch_amalgamated.hpp"
+
+TEST_CASE("ConFrameVecTyped matches ConFrameVec", "[ConFrameVecTyped]") {
+  yodecon::helpers::file::MappedFile mapped{"test_data/sulfolene.con"};
+  auto expected =
+      yodecon::create_single_con<yodecon::types::ConFrameVec>(mapped.view());
+  auto result = yodecon::create_single_con<yodecon::types::ConFrameVecTyped>(
+      mapped.view());
+
+  REQUIRE(result.natm_types == 4);
+  REQUIRE(result.type_symbols ==
+          std::vector<std::string>{"O", "C", "H", "S"});
+  REQUIRE(result.type_index.size() == 13);
+  REQUIRE(result.type_index[0] == 0);
+  REQUIRE(result.type_index[12] == 3);
+  REQUIRE(result.symbol(12) == "S");
+  REQUIRE(result.symbols() == expected.symbol);
+  REQUIRE(result.x == expected.x);
+  REQUIRE(result.y == expected.y);
+  REQUIRE(result.z == expected.z);
+  REQUIRE(result.is_fixed == expected.is_fixed);
+  REQUIRE(result.atom_id == expected.atom_id);
+  REQUIRE(yodecon::symbols_to_atomic_numbers(result) ==
+          yodecon::symbols_to_atomic_numbers(expected.symbol));
+}
+
+TEST_CASE("ConFrameVecTyped from lines and streams", "[ConFrameVecTyped]") {
+  auto lines =
+      yodecon::helpers::file::read_con_file("test_data/tiny_multi_cuh2.con");
+  auto from_lines =
+      yodecon::create_multi_con<yodecon::types::ConFrameVecTyped>(lines);
+  auto expected = yodecon::create_multi_con<yodecon::types::ConFrameVec>(lines);
+  REQUIRE(from_lines.size() == 2);
+
+  yodecon::ConFrameStream<yodecon::types::ConFrameVecTyped> stream{
+      "test_data/tiny_multi_cuh2.con"};
+  size_t nframes{0};
+  for (const auto &frame : stream) {
+    REQUIRE(frame.type_symbols == std::vector<std::string>{"Cu", "H"});
+    REQUIRE(frame.symbols() == expected[nframes].symbol);
+    REQUIRE(from_lines[nframes].symbols() == expected[nframes].symbol);
+    REQUIRE(frame.x == expected[nframes].x);
+    REQUIRE(from_lines[nframes].atom_id == expected[nframes].atom_id);
+    nframes++;
+  }
+  REQUIRE(nframes == 2);
+}
@@ -0,0 +1,255 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+#include "readCon/include/ConIndex.hpp"
+#include "readCon/include/ConIndexFile.hpp"
+#include "readCon/include/ConSummary.hpp"
+
+#include "catch2/catch_amalgamated.hpp"
+
+constexpr double fp_tol{1e-12};
+
+TEST_CASE("ConIndex locates every frame", "[ConIndex]") {
+  yodecon::helpers::file::MappedFile mapped{"test_data/tiny_multi_cuh2.con"};
+  yodecon::ConIndex index{mapped.view()};
+
+  REQUIRE(index.size() == 2);
+  REQUIRE(index.at(0).offset == 0);
+  REQUIRE(index.at(0).natoms == 4);
+  REQUIRE(index.at(1).offset == index.at(0).nbytes);
+  REQUIRE(index.at(1).natoms == 4);
+  REQUIRE(index.at(1).offset + index.at(1).nbytes == mapped.size());
+  REQUIRE(index.frame_view(1).substr(0, 18) == "Random Number Seed");
+  REQUIRE_THROWS_AS(index.at(2), std::out_of_range);
+}
+
+TEST_CASE("ConIndex read_frame matches create_multi_con", "[ConIndex]") {
+  yodecon::helpers::file::MappedFile mapped{"test_data/tiny_multi_cuh2.con"};
+  yodecon::ConIndex index{mapped.view()};
+  auto all =
+      yodecon::create_multi_con<yodecon::types::ConFrameVec>(mapped.view());
+
+  for (size_t frm{0}; frm < index.size(); frm++) {
+    auto single = index.read_frame<yodecon::types::ConFrameVec>(frm);
+    REQUIRE(single.x == all[frm].x);
+    REQUIRE(single.y == all[frm].y);
+    REQUIRE(single.z == all[frm].z);
+    REQUIRE(single.atom_id == all[frm].atom_id);
+  }
+  auto last = index.read_frame<yodecon::types::ConFrame>(1);
+  REQUIRE_THAT(last.atom_data[3].x,
+               Catch::Matchers::WithinAbs(7.76944285714285154, fp_tol));
+}
+
+TEST_CASE("ConIndex single frame and empty input", "[ConIndex]") {
+  yodecon::helpers::file::MappedFile mapped{"test_data/cuh2.con"};
+  yodecon::ConIndex index{mapped.view()};
+  REQUIRE(index.size() == 1);
+  REQUIRE(index.at(0).natoms == 218);
+
+  yodecon::ConIndex empty{std::string_view{}};
+  REQUIRE(empty.empty());
+}
+
+TEST_CASE("ConIndex rejects truncated frames", "[ConIndex]") {
+  yodecon::helpers::file::MappedFile mapped{"test_data/tiny_multi_cuh2.con"};
+  auto truncated = mapped.view().substr(0, mapped.size() - 80);
+  REQUIRE_THROWS_AS(yodecon::ConIndex{truncated}, std::invalid_argument);
+}
+
+TEST_CASE("Sidecar index is reused and extended on append", "[ConIndexFile]") {
+  namespace fs = std::filesystem;
+  const std::string fname =
+      (fs::temp_directory_path() / "readcon_sidecar_test.con").string();
+  const std::string sidecar = yodecon::idxfile::sidecar_path(fname);
+  fs::remove(sidecar);
+
+  yodecon::helpers::file::MappedFile source{"test_data/tiny_multi_cuh2.con"};
+  yodecon::ConIndex source_index{source.view()};
+  auto write_prefix = [&](size_t a_nbytes) {
+    std::ofstream ofs{fname, std::ios::binary | std::ios::trunc};
+    ofs.write(source.data(), static_cast<std::streamsize>(a_nbytes));
+  };
+
+  // A single frame, freshly indexed
+  write_prefix(source_index.at(0).nbytes);
+  {
+    yodecon::helpers::file::MappedFile mapped{fname};
+    auto index = yodecon::idxfile::load_or_build(fname, mapped.view());
+    REQUIRE(index.size() == 1);
+    REQUIRE(fs::exists(sidecar));
+
+    yodecon::idxfile::SidecarInfo info{};
+    auto frames = yodecon::idxfile::read_sidecar(fname, info);
+    REQUIRE(frames.has_value());
+    REQUIRE(frames->size() == 1);
+    REQUIRE(info.file_size == mapped.size());
+    REQUIRE(info.indexed_bytes == mapped.size());
+    REQUIRE(frames->at(0).natoms == 4);
+    REQUIRE(frames->at(0).natm_types == 2);
+    REQUIRE(frames->at(0).boxl == source_index.at(0).boxl);
+
+    // Unchanged file, the stored offsets are used as is
+    auto reopened = yodecon::idxfile::load_or_build(fname, mapped.view());
+    REQUIRE(reopened.size() == 1);
+    REQUIRE(reopened.at(0).nbytes == index.at(0).nbytes);
+  }
+
+  // Appending the second frame only scans the new bytes
+  write_prefix(source.size());
+  {
+    yodecon::helpers::file::MappedFile mapped{fname};
+    auto index = yodecon::idxfile::load_or_build(fname, mapped.view());
+    REQUIRE(index.size() == 2);
+    REQUIRE(index.at(1).offset == source_index.at(1).offset);
+    auto frame = index.read_frame<yodecon::types::ConFrameVec>(1);
+    REQUIRE_THAT(frame.x[2],
+                 Catch::Matchers::WithinAbs(8.85495714285713653, fp_tol));
+
+    yodecon::idxfile::SidecarInfo info{};
+    auto frames = yodecon::idxfile::read_sidecar(fname, info);
+    REQUIRE(frames->size() == 2);
+    REQUIRE(info.file_size == source.size());
+  }
+
+  // A corrupt sidecar is ignored and rebuilt
+  {
+    std::ofstream ofs{sidecar, std::ios::binary | std::ios::trunc};
+    ofs << "not an index";
+  }
+  {
+    yodecon::helpers::file::MappedFile mapped{fname};
+    yodecon::idxfile::SidecarInfo info{};
+    REQUIRE_FALSE(yodecon::idxfile::read_sidecar(fname, info).has_value());
+    auto index = yodecon::idxfile::load_or_build(fname, mapped.view());
+    REQUIRE(index.size() == 2);
+    REQUIRE(yodecon::idxfile::read_sidecar(fname, info).has_value());
+  }
+
+  // So is one that cannot be mapped at all, here a directory in its place
+  fs::remove(sidecar);
+  fs::create_directory(sidecar);
+  {
+    yodecon::helpers::file::MappedFile mapped{fname};
+    yodecon::idxfile::SidecarInfo info{};
+    REQUIRE_FALSE(yodecon::idxfile::read_sidecar(fname, info).has_value());
+    auto index = yodecon::idxfile::load_or_build(fname, mapped.view());
+    REQUIRE(index.size() == 2);
+  }
+  fs::remove(sidecar);
+  fs::remove(fname);
+}
+
+TEST_CASE("Atomic writes leave no temporary files", "[ConIndexFile]") {
+  namespace fs = std::filesystem;
+  const fs::path dir = fs::temp_directory_path() / "readcon_atomic_test";
+  fs::remove_all(dir);
+  fs::create_directory(dir);
+  const std::string fname = (dir / "out.cidx").string();
+
+  // Concurrent writers never share a temporary file
+  std::vector<std::thread> writers;
+  std::atomic<size_t> nfailed{0};
+  for (const char fill : {'a', 'b', 'c', 'd'}) {
+    writers.emplace_back([&fname, &nfailed, fill]() {
+      for (size_t rep{0}; rep < 20; rep++) {
+        if (!yodecon::helpers::file::write_atomically(
+                fname, std::string(4096, fill))) {
+          nfailed++;
+        }
+      }
+    });
+  }
+  for (auto &writer : writers) {
+    writer.join();
+  }
+  REQUIRE(nfailed == 0);
+  std::ifstream ifs{fname, std::ios::binary};
+  const std::string contents{std::istreambuf_iterator<char>{ifs},
+                             std::istreambuf_iterator<char>{}};
+  REQUIRE(contents.size() == 4096);
+  REQUIRE(contents == std::string(4096, contents[0]));
+  REQUIRE(std::distance(fs::directory_iterator{dir},
+                        fs::directory_iterator{}) == 1);
+
+  // Nothing is left behind when the file cannot be written
+  REQUIRE_FALSE(yodecon::helpers::file::write_atomically(
+      (dir / "missing" / "out.cidx").string(), "bytes"));
+  REQUIRE(std::distance(fs::directory_iterator{dir},
+                        fs::directory_iterator{}) == 1);
+  fs::remove_all(dir);
+}
+
+TEST_CASE("Header scan summarizes frames", "[ConSummary]") {
+  yodecon::helpers::file::MappedFile mapped{"test_data/tiny_multi_cuh2.con"};
+  auto summary = yodecon::scan_con(mapped.view());
+  REQUIRE(summary.size() == 2);
+  REQUIRE(summary.natoms == std::vector<size_t>{4, 4});
+  REQUIRE(summary.natm_types == std::vector<size_t>{2, 2});
+  REQUIRE(summary.total_atoms() == 8);
+  REQUIRE_THAT(summary.boxl[1][0],
+               Catch::Matchers::WithinAbs(15.3456, fp_tol));
+  REQUIRE_THAT(summary.angles[0][2], Catch::Matchers::WithinAbs(90, fp_tol));
+
+  auto from_file = yodecon::scan_con_file("test_data/cuh2.con");
+  REQUIRE(from_file.size() == 1);
+  REQUIRE(from_file.natoms[0] == 218);
+  REQUIRE_FALSE(
+      std::filesystem::exists("test_data/cuh2.con" + std::string{".idx"}));
+
+  REQUIRE(yodecon::scan_con(std::string_view{}).empty());
+  REQUIRE_THROWS_AS(
+      yodecon::scan_con(mapped.view().substr(0, mapped.size() - 80)),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(yodecon::scan_con_file("test_data/nope.con"),
+                    std::runtime_error);
+}
+
+TEST_CASE("Frame slices only parse the selected frames", "[FrameSlice]") {
+  yodecon::helpers::file::MappedFile mapped{"test_data/tiny_multi_cuh2.con"};
+  std::string trajectory;
+  for (size_t rep{0}; rep < 10; rep++) {
+    trajectory += mapped.view();
+  }
+  auto full =
+      yodecon::create_multi_con<yodecon::types::ConFrameVec>(trajectory);
+  REQUIRE(full.size() == 20);
+
+  auto sliced = yodecon::create_multi_con_slice<yodecon::types::ConFrameVec>(
+      trajectory, yodecon::FrameSlice{1, 15, 4});
+  REQUIRE(sliced.size() == 4);
+  for (size_t idx{0}; idx < sliced.size(); idx++) {
+    REQUIRE(sliced[idx].x == full[1 + 4 * idx].x);
+    REQUIRE(sliced[idx].atom_id == full[1 + 4 * idx].atom_id);
+  }
+
+  yodecon::FrameSlice every_third;
+  every_third.step = 3;
+  yodecon::ParseOptions positions;
+  positions.columns = yodecon::columns::Positions;
+  auto strided = yodecon::create_multi_con_slice<yodecon::types::ConFrameVec>(
+      trajectory, every_third, positions);
+  REQUIRE(strided.size() == 7);
+  REQUIRE(strided[6].z == full[18].z);
+  REQUIRE(strided[6].atom_id.empty());
+
+  REQUIRE(yodecon::create_multi_con_slice<yodecon::types::ConFrame>(
+              trajectory, yodecon::FrameSlice{25})
+              .empty());
+  REQUIRE_THROWS_AS(yodecon::create_multi_con_slice<yodecon::types::ConFrame>(
+                        trajectory, yodecon::FrameSlice{0, 4, 0}),
+                    std::invalid_argument);
+  // Frames past stop are never looked at, even when truncated
+  auto truncated = std::string_view{trajectory}.substr(0, mapped.size() + 50);
+  REQUIRE(yodecon::create_multi_con_slice<yodecon::types::ConFrame>(
+              truncated, yodecon::FrameSlice{0, 1})
+              .size() == 1);
+  REQUIRE_THROWS_AS(yodecon::create_multi_con_slice<yodecon::types::ConFrame>(
+                        truncated, yodecon::FrameSlice{3}),
+                    std::invalid_argument);
+}
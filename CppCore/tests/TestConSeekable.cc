@@ -0,0 +1,193 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <filesystem>
+#include <fstream>
+
+#include "readCon/include/ConFrameStream.hpp"
+#include "readCon/include/ConSeekable.hpp"
+
+#include "TestHelpers.hpp"
+
+#include "catch2/catch_amalgamated.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+using yodecon::compression::Codec;
+using yodecon::testing::read_plain;
+
+// Seven copies of the two frames of tiny_multi_cuh2
+std::string make_trajectory() {
+  std::string out;
+  const std::string plain = read_plain("test_data/tiny_multi_cuh2.con");
+  for (size_t copy{0}; copy < 7; copy++) {
+    out += plain;
+  }
+  return out;
+}
+
+std::string temp_name(Codec a_codec, size_t a_frames_per_block) {
+  return yodecon::testing::temp_name(
+      "seekable_" + std::string{yodecon::compression::codec_name(a_codec)} +
+      "_" + std::to_string(a_frames_per_block) + ".con");
+}
+
+void remove_with_sidecar(const std::string &a_fname) {
+  fs::remove(a_fname);
+  fs::remove(yodecon::seekable::sidecar_path(a_fname));
+}
+
+const std::vector<Codec> Codecs{Codec::Gzip, Codec::Xz, Codec::Zstd};
+} // namespace
+
+TEST_CASE("Seekable trajectories read any frame", "[ConSeekable]") {
+  const std::string plain = make_trajectory();
+  auto expected =
+      yodecon::create_multi_con<yodecon::types::ConFrameVec>(plain);
+  REQUIRE(expected.size() == 14);
+  for (const auto codec : Codecs) {
+    if (!yodecon::compression::is_supported(codec)) {
+      REQUIRE_THROWS_AS(
+          yodecon::seekable::SeekableWriter(temp_name(codec, 1), codec),
+          std::runtime_error);
+      continue;
+    }
+    for (const size_t per_block : {1, 3, 20}) {
+      DYNAMIC_SECTION(yodecon::compression::codec_name(codec)
+                      << " with " << per_block << " frames per block") {
+        const std::string fname = temp_name(codec, per_block);
+        {
+          yodecon::seekable::SeekableWriter out{fname, codec, per_block};
+          // Fed in two pieces, blocks may span both
+          const size_t half = plain.size() / 2;
+          out.write_frames(plain.substr(0, half));
+          out.write_frames(plain.substr(half));
+          out.finish();
+          REQUIRE(out.size() == expected.size());
+        }
+        REQUIRE(fs::exists(yodecon::seekable::sidecar_path(fname)));
+
+        yodecon::seekable::SeekableReader archive{fname};
+        REQUIRE(archive.codec() == codec);
+        REQUIRE(archive.size() == expected.size());
+        REQUIRE(archive.blocks().size() ==
+                (expected.size() + per_block - 1) / per_block);
+        // Backwards, so every block is decompressed again
+        for (size_t idx = archive.size(); idx-- > 0;) {
+          auto frame =
+              archive.read_frame<yodecon::types::ConFrameVec>(idx);
+          REQUIRE(frame.x == expected[idx].x);
+          REQUIRE(frame.atom_id == expected[idx].atom_id);
+        }
+        REQUIRE_THROWS_AS(archive.frame_view(archive.size()),
+                          std::out_of_range);
+
+        // Still an ordinary compressed trajectory
+        auto input = yodecon::compression::open_input(fname);
+        REQUIRE(yodecon::testing::slurp(*input) == plain);
+
+        // A lost sidecar is rebuilt from the blocks
+        const auto stored = archive.blocks();
+        fs::remove(yodecon::seekable::sidecar_path(fname));
+        yodecon::seekable::SeekableReader rebuilt{fname};
+        REQUIRE(fs::exists(yodecon::seekable::sidecar_path(fname)));
+        REQUIRE(rebuilt.blocks().size() == stored.size());
+        for (size_t blk{0}; blk < stored.size(); blk++) {
+          REQUIRE(rebuilt.blocks()[blk].offset == stored[blk].offset);
+          REQUIRE(rebuilt.blocks()[blk].first_frame ==
+                  stored[blk].first_frame);
+          REQUIRE(rebuilt.blocks()[blk].raw_bytes == stored[blk].raw_bytes);
+        }
+        REQUIRE(rebuilt.frame_view(5) == archive.frame_view(5));
+        remove_with_sidecar(fname);
+      }
+    }
+  }
+}
+
+TEST_CASE("Stale block indices are not trusted", "[ConSeekable]") {
+  const Codec codec = Codec::Gzip;
+  if (!yodecon::compression::is_supported(codec)) {
+    return;
+  }
+  const std::string plain = make_trajectory();
+  const std::string fname = temp_name(codec, 0);
+  {
+    yodecon::seekable::SeekableWriter out{fname, codec, 2};
+    out.write_frames(plain);
+  }
+  // Rewritten with other blocks, leaving the old sidecar behind
+  const std::string sidecar = read_plain(
+      yodecon::seekable::sidecar_path(fname));
+  {
+    yodecon::seekable::SeekableWriter out{fname, codec, 5};
+    out.write_frames(plain);
+  }
+  {
+    std::ofstream ofs{yodecon::seekable::sidecar_path(fname),
+                      std::ios::binary | std::ios::trunc};
+    ofs << sidecar;
+  }
+  yodecon::seekable::SeekableReader archive{fname, false};
+  REQUIRE(archive.blocks().size() == 3);
+  REQUIRE(archive.size() == 14);
+  remove_with_sidecar(fname);
+}
+
+TEST_CASE("Unwinding discards unfinished seekable files", "[ConSeekable]") {
+  const Codec codec = Codec::Gzip;
+  if (!yodecon::compression::is_supported(codec)) {
+    return;
+  }
+  const std::string plain = make_trajectory();
+  const std::string fname = temp_name(codec, 0);
+  const auto interrupted = [&] {
+    yodecon::seekable::SeekableWriter out{fname, codec, 2};
+    out.write_frames(plain);
+    throw std::runtime_error("conversion interrupted");
+  };
+  REQUIRE_THROWS_AS(interrupted(), std::runtime_error);
+  REQUIRE_FALSE(fs::exists(fname));
+  REQUIRE_FALSE(fs::exists(yodecon::seekable::sidecar_path(fname)));
+
+  // Exceptions caught before the writer was made do not count
+  try {
+    throw std::runtime_error("earlier failure");
+  } catch (const std::runtime_error &) {
+    {
+      yodecon::seekable::SeekableWriter out{fname, codec, 2};
+      out.write_frames(plain);
+    }
+    REQUIRE(yodecon::seekable::SeekableReader{fname, false}.size() == 14);
+  }
+  yodecon::seekable::SeekableWriter out{fname, codec, 2};
+  out.write_frames(plain);
+  out.discard();
+  out.finish();
+  REQUIRE_FALSE(fs::exists(fname));
+}
+
+TEST_CASE("Seekable trajectories need frame aligned blocks", "[ConSeekable]") {
+  const Codec codec = Codec::Gzip;
+  if (!yodecon::compression::is_supported(codec)) {
+    return;
+  }
+  const std::string plain = read_plain("test_data/tiny_multi_cuh2.con");
+  // Without the last atom line
+  const size_t cut = plain.rfind('\n', plain.size() - 2) + 1;
+  REQUIRE_THROWS_AS(yodecon::seekable::SeekableWriter(temp_name(codec, 0),
+                                                      Codec::None),
+                    std::runtime_error);
+  {
+    yodecon::seekable::SeekableWriter out{temp_name(codec, 0), codec};
+    REQUIRE_THROWS_AS(out.write_frames(plain.substr(0, cut)),
+                      std::invalid_argument);
+  }
+  // One member cutting the second frame in half
+  const std::string packed =
+      yodecon::compression::compress(plain.substr(0, cut), codec) +
+      yodecon::compression::compress(plain.substr(cut), codec);
+  REQUIRE_THROWS_AS(yodecon::seekable::build_blocks(packed, codec),
+                    std::invalid_argument);
+  remove_with_sidecar(temp_name(codec, 0));
+}
@@ -0,0 +1,60 @@
+#pragma once
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "readCon/include/BaseTypes.hpp"
+#include "readCon/include/ReadCon.hpp"
+
+#include "catch2/catch_amalgamated.hpp"
+
+// Small utilities shared by the test executables
+namespace yodecon::testing {
+//! Everything left in `a_input`
+inline std::string slurp(std::istream &a_input) {
+  return {std::istreambuf_iterator<char>{a_input},
+          std::istreambuf_iterator<char>{}};
+}
+
+//! The bytes of `a_fname`, without any decompression
+inline std::string read_plain(const std::string &a_fname) {
+  std::ifstream ifs{a_fname, std::ios::binary};
+  return slurp(ifs);
+}
+
+//! Every frame of the trajectory `a_fname`, parsed as `ConFrameLike`
+template <typename ConFrameLike>
+std::vector<ConFrameLike> load_frames(const std::string &a_fname) {
+  return yodecon::create_multi_con<ConFrameLike>(read_plain(a_fname));
+}
+
+//! Scratch file `readcon_<a_name>` in the system temporary directory
+inline std::string temp_name(const std::string &a_name) {
+  return (std::filesystem::temp_directory_path() / ("readcon_" + a_name))
+      .string();
+}
+
+//! Requires every field of the two frames to be equal
+template <typename Real>
+void require_same(const yodecon::types::BasicConFrameVec<Real> &a_lhs,
+                  const yodecon::types::BasicConFrameVec<Real> &a_rhs) {
+  REQUIRE(a_lhs.prebox_header == a_rhs.prebox_header);
+  REQUIRE(a_lhs.postbox_header == a_rhs.postbox_header);
+  REQUIRE(a_lhs.boxl == a_rhs.boxl);
+  REQUIRE(a_lhs.angles == a_rhs.angles);
+  REQUIRE(a_lhs.natm_types == a_rhs.natm_types);
+  REQUIRE(a_lhs.natms_per_type == a_rhs.natms_per_type);
+  REQUIRE(a_lhs.masses_per_type == a_rhs.masses_per_type);
+  REQUIRE(a_lhs.symbol == a_rhs.symbol);
+  REQUIRE(a_lhs.x == a_rhs.x);
+  REQUIRE(a_lhs.y == a_rhs.y);
+  REQUIRE(a_lhs.z == a_rhs.z);
+  REQUIRE(a_lhs.is_fixed == a_rhs.is_fixed);
+  REQUIRE(a_lhs.atom_id == a_rhs.atom_id);
+}
+} // namespace yodecon::testing
@@ -0,0 +1,136 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include "readCon/include/ReadCon.hpp"
+
+#include "catch2/catch_amalgamated.hpp"
+
+constexpr double fp_tol{1e-12};
+
+TEST_CASE("LineCursor splits lines without terminators", "[LineCursor]") {
+  yodecon::helpers::string::LineCursor cursor{"Cu\r\nCoordinates\n\nlast"};
+  std::string_view line;
+  REQUIRE(cursor.next(line));
+  REQUIRE(line == "Cu");
+  REQUIRE(cursor.next(line));
+  REQUIRE(line == "Coordinates");
+  REQUIRE(cursor.next(line));
+  REQUIRE(line.empty());
+  REQUIRE_FALSE(cursor.at_end());
+  REQUIRE(cursor.next(line));
+  REQUIRE(line == "last");
+  REQUIRE(cursor.at_end());
+  REQUIRE_FALSE(cursor.next(line));
+}
+
+TEST_CASE("MappedFile matches read_con_file", "[MappedFile]") {
+  yodecon::helpers::file::MappedFile mapped{"test_data/tiny_multi_cuh2.con"};
+  auto lines =
+      yodecon::helpers::file::read_con_file("test_data/tiny_multi_cuh2.con");
+  REQUIRE(mapped.size() > 0);
+
+  yodecon::helpers::string::LineCursor cursor{mapped.view()};
+  std::string_view line;
+  size_t nlines{0};
+  while (cursor.next(line)) {
+    REQUIRE(line == lines[nlines]);
+    nlines++;
+  }
+  REQUIRE(nlines == lines.size());
+}
+
+TEST_CASE("MappedFile throws on missing files", "[MappedFile]") {
+  REQUIRE_THROWS_AS(yodecon::helpers::file::MappedFile{"test_data/nope.con"},
+                    std::runtime_error);
+}
+
+TEST_CASE("MappedFile multi frame parse matches line parse", "[MappedFile]") {
+  yodecon::helpers::file::MappedFile mapped{"test_data/tiny_multi_cuh2.con"};
+  auto lines =
+      yodecon::helpers::file::read_con_file("test_data/tiny_multi_cuh2.con");
+
+  auto from_view =
+      yodecon::create_multi_con<yodecon::types::ConFrameVec>(mapped.view());
+  auto from_lines =
+      yodecon::create_multi_con<yodecon::types::ConFrameVec>(lines);
+
+  REQUIRE(from_view.size() == 2);
+  REQUIRE(from_view.size() == from_lines.size());
+  for (size_t frm{0}; frm < from_view.size(); frm++) {
+    const auto &lhs = from_view[frm];
+    const auto &rhs = from_lines[frm];
+    REQUIRE(lhs.prebox_header == rhs.prebox_header);
+    REQUIRE(lhs.postbox_header == rhs.postbox_header);
+    REQUIRE(lhs.boxl == rhs.boxl);
+    REQUIRE(lhs.angles == rhs.angles);
+    REQUIRE(lhs.natms_per_type == rhs.natms_per_type);
+    REQUIRE(lhs.masses_per_type == rhs.masses_per_type);
+    REQUIRE(lhs.symbol == rhs.symbol);
+    REQUIRE(lhs.x == rhs.x);
+    REQUIRE(lhs.y == rhs.y);
+    REQUIRE(lhs.z == rhs.z);
+    REQUIRE(lhs.is_fixed == rhs.is_fixed);
+    REQUIRE(lhs.atom_id == rhs.atom_id);
+  }
+  REQUIRE_THAT(from_view[1].x[2],
+               Catch::Matchers::WithinAbs(8.85495714285713653, fp_tol));
+}
+
+TEST_CASE("MappedFile single frame parse into ConFrame", "[MappedFile]") {
+  yodecon::helpers::file::MappedFile mapped{"test_data/sulfolene.con"};
+  auto result =
+      yodecon::create_single_con<yodecon::types::ConFrame>(mapped.view());
+  REQUIRE(result.natm_types == 4);
+  REQUIRE(result.atom_data.size() == 13);
+  REQUIRE(result.atom_data[0].symbol == "O");
+  REQUIRE_THAT(result.atom_data[0].x,
+               Catch::Matchers::WithinAbs(10.477713, fp_tol));
+  REQUIRE(result.atom_data[12].symbol == "S");
+}
+
+TEST_CASE("Truncated buffers throw", "[MappedFile]") {
+  std::string_view truncated{"Random Number Seed\nTime\n"
+                             "15.345600\t21.702000\t100.000000\n"
+                             "90.000000\t90.000000\t90.000000\n"
+                             "0 0\n218 0 1\n1\n2\n63.546000\nCu\n"
+                             "Coordinates of Component 1\n"
+                             "0.6394 0.9045 6.9753 1 0\n"};
+  REQUIRE_THROWS_AS(
+      yodecon::create_single_con<yodecon::types::ConFrameVec>(truncated),
+      std::invalid_argument);
+
+  // The line based parsers must not pad the missing atom with defaults
+  const std::vector<std::string> lines{"Random Number Seed",
+                                       "Time",
+                                       "15.345600\t21.702000\t100.000000",
+                                       "90.000000\t90.000000\t90.000000",
+                                       "0 0",
+                                       "218 0 1",
+                                       "1",
+                                       "2",
+                                       "63.546000",
+                                       "Cu",
+                                       "Coordinates of Component 1",
+                                       "0.6394 0.9045 6.9753 1 0"};
+  REQUIRE_THROWS_AS(
+      yodecon::create_single_con<yodecon::types::ConFrameVec>(lines),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(yodecon::create_single_con<yodecon::types::ConFrame>(lines),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS(
+      yodecon::create_single_con<yodecon::types::ConFrameVecFloat>(lines),
+      std::invalid_argument);
+}
+
+TEST_CASE("Implausible atom counts throw before allocating", "[MappedFile]") {
+  std::string_view huge{"Random Number Seed\nTime\n"
+                        "15.345600\t21.702000\t100.000000\n"
+                        "90.000000\t90.000000\t90.000000\n"
+                        "0 0\n218 0 1\n1\n4000000000000\n63.546000\nCu\n"
+                        "Coordinates of Component 1\n"
+                        "0.6394 0.9045 6.9753 1 0\n"};
+  REQUIRE_THROWS_AS(
+      yodecon::create_single_con<yodecon::types::ConFrameVec>(huge),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(yodecon::create_single_con<yodecon::types::ConFrame>(huge),
+                    std::invalid_argument);
+}
@@ -0,0 +1,70 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "readCon/include/ConIndex.hpp"
+
+#include "catch2/catch_amalgamated.hpp"
+
+TEST_CASE("ThreadPool visits every index once", "[ThreadPool]") {
+  yodecon::helpers::parallel::ThreadPool pool{4};
+  REQUIRE(pool.size() == 4);
+  std::vector<std::atomic<int>> hits(1000);
+  pool.parallel_for(hits.size(), [&](size_t a_idx) { hits[a_idx]++; });
+  for (const auto &hit : hits) {
+    REQUIRE(hit.load() == 1);
+  }
+  // Nothing to do is fine too
+  pool.parallel_for(0, [](size_t) { throw std::logic_error("unreachable"); });
+}
+
+TEST_CASE("ThreadPool rethrows worker exceptions", "[ThreadPool]") {
+  yodecon::helpers::parallel::ThreadPool pool{3};
+  REQUIRE_THROWS_AS(pool.parallel_for(100,
+                                      [](size_t a_idx) {
+                                        if (a_idx == 42) {
+                                          throw std::runtime_error("boom");
+                                        }
+                                      }),
+                    std::runtime_error);
+  // The pool stays usable afterwards
+  std::atomic<size_t> count{0};
+  pool.parallel_for(10, [&](size_t) { count++; });
+  REQUIRE(count == 10);
+}
+
+TEST_CASE("Parallel loader matches create_multi_con", "[Parallel]") {
+  yodecon::helpers::file::MappedFile mapped{"test_data/tiny_multi_cuh2.con"};
+  std::string trajectory;
+  for (size_t rep{0}; rep < 50; rep++) {
+    trajectory += mapped.view();
+  }
+  auto sequential =
+      yodecon::create_multi_con<yodecon::types::ConFrameVec>(trajectory);
+  REQUIRE(sequential.size() == 100);
+
+  for (size_t nthreads : {1, 3, 8}) {
+    auto parallel =
+        yodecon::create_multi_con_parallel<yodecon::types::ConFrameVec>(
+            trajectory, nthreads);
+    REQUIRE(parallel.size() == sequential.size());
+    for (size_t frm{0}; frm < parallel.size(); frm++) {
+      REQUIRE(parallel[frm].x == sequential[frm].x);
+      REQUIRE(parallel[frm].y == sequential[frm].y);
+      REQUIRE(parallel[frm].z == sequential[frm].z);
+      REQUIRE(parallel[frm].atom_id == sequential[frm].atom_id);
+      REQUIRE(parallel[frm].symbol == sequential[frm].symbol);
+    }
+  }
+
+  auto lines =
+      yodecon::helpers::file::read_con_file("test_data/tiny_multi_cuh2.con");
+  auto from_lines = yodecon::create_multi_con<yodecon::types::ConFrame>(lines);
+  auto from_pool = yodecon::create_multi_con_parallel<yodecon::types::ConFrame>(
+      mapped.view(), 2);
+  REQUIRE(from_lines.size() == from_pool.size());
+  REQUIRE(from_lines[1].atom_data[2].x == from_pool[1].atom_data[2].x);
+}
@@ -0,0 +1,167 @@
+// MIT License
+// Copyright 2023--present Rohit Goswami <HaoZeke>
+#include <filesystem>
+#include <sstream>
+
+#include "readCon/include/ConBinary.hpp"
+#include "readCon/include/ReadCon.hpp"
+#include "readCon/include/WriteCon.hpp"
+
+#include "TestHelpers.hpp"
+
+#include "catch2/catch_amalgamated.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+using yodecon::testing::load_frames;
+using yodecon::testing::read_plain;
+
+// Written with printf as eON does, "%22.17f %22.17f %22.17f %d %4d"
+const std::string EonFrame{"Random Number Seed\n"
+                           "Time\n"
+                           "15.345600\t21.702000\t100.000000\n"
+                           "90.000000\t90.000000\t90.000000\n"
+                           "0 0\n"
+                           "218 0 1\n"
+                           "2\n"
+                           "2 1\n"
+                           "63.546000 1.007930\n"
+                           "Cu\n"
+                           "Coordinates of Component 1\n"
+                           "   0.63940000000000108    0.90450000000000019"
+                           "    6.97529999999999539 1    0\n"
+                           "   3.19699999999999873    0.90450000000000019"
+                           "   -6.97529999999999539 1    1\n"
+                           "H\n"
+                           "Coordinates of Component 2\n"
+                           "   8.68229999999999968 12345.94700000000011642"
+                           "   11.73299999999999343 0 12345\n"};
+} // namespace
+
+TEST_CASE("Frames are written in the eON layout", "[WriteCon]") {
+  auto frame = yodecon::create_single_con<yodecon::types::ConFrameVec>(
+      std::string_view{EonFrame});
+  std::ostringstream vec_out;
+  yodecon::write_con(vec_out, frame);
+  REQUIRE(vec_out.str() == EonFrame);
+
+  auto atoms = yodecon::create_single_con<yodecon::types::ConFrame>(
+      std::string_view{EonFrame});
+  std::ostringstream atom_out;
+  yodecon::write_con(atom_out, atoms);
+  REQUIRE(atom_out.str() == EonFrame);
+
+  std::string text;
+  yodecon::format_con(frame, text);
+  yodecon::format_con(atoms, text);
+  REQUIRE(text == EonFrame + EonFrame);
+
+  frame.natms_per_type[1] = 2;
+  REQUIRE_THROWS_AS(yodecon::format_con(frame, text), std::invalid_argument);
+
+  // A component is written under one symbol, so it cannot mix them
+  frame.natms_per_type[1] = 1;
+  frame.symbol[1] = "Ag";
+  atoms.atom_data[1].symbol = "Ag";
+  REQUIRE_THROWS_AS(yodecon::format_con(frame, text), std::invalid_argument);
+  REQUIRE_THROWS_AS(yodecon::format_con(atoms, text), std::invalid_argument);
+  std::ostringstream mixed;
+  REQUIRE_THROWS_AS(yodecon::write_con(mixed, frame), std::invalid_argument);
+  REQUIRE(mixed.str().empty());
+}
+
+TEST_CASE("Written trajectories read back unchanged", "[WriteCon]") {
+  for (const std::string stem : {"tiny_multi_cuh2", "cuh2", "sulfolene"}) {
+    DYNAMIC_SECTION(stem) {
+      const std::string fname = "test_data/" + stem + ".con";
+      const auto frames = load_frames<yodecon::types::ConFrameVec>(fname);
+      std::ostringstream out;
+      yodecon::write_multi_con(out, frames);
+      const auto again =
+          yodecon::create_multi_con<yodecon::types::ConFrameVec>(out.str());
+      REQUIRE(again.size() == frames.size());
+      for (size_t idx{0}; idx < frames.size(); idx++) {
+        REQUIRE(again[idx].prebox_header == frames[idx].prebox_header);
+        REQUIRE(again[idx].boxl == frames[idx].boxl);
+        REQUIRE(again[idx].masses_per_type == frames[idx].masses_per_type);
+        REQUIRE(again[idx].symbol == frames[idx].symbol);
+        REQUIRE(again[idx].x == frames[idx].x);
+        REQUIRE(again[idx].y == frames[idx].y);
+        REQUIRE(again[idx].z == frames[idx].z);
+        REQUIRE(again[idx].is_fixed == frames[idx].is_fixed);
+        REQUIRE(again[idx].atom_id == frames[idx].atom_id);
+      }
+      // Writing is a fixed point after the first pass
+      std::ostringstream twice;
+      yodecon::write_multi_con(twice, again);
+      REQUIRE(twice.str() == out.str());
+    }
+  }
+}
+
+TEST_CASE("Files round trip through the binary format", "[WriteCon]") {
+  const std::string conb = yodecon::testing::temp_name("write_test.conb");
+  const std::string con = yodecon::testing::temp_name("write_test.con");
+  REQUIRE(yodecon::conb::convert_to_conb("test_data/cuh2.con", conb) == 1);
+  yodecon::conb::ConbReader traj{conb};
+  yodecon::write_multi_con(con, traj.read_all());
+  std::ostringstream direct;
+  yodecon::write_multi_con(
+      direct, load_frames<yodecon::types::ConFrameVec>("test_data/cuh2.con"));
+  REQUIRE(read_plain(con) == direct.str());
+
+  // Small chunks flush many times, with the same result
+  std::ostringstream chunked;
+  {
+    yodecon::ConWriter out{chunked, 64};
+    for (const auto &frame : load_frames<yodecon::types::ConFrameFloat>(
+             "test_data/tiny_multi_cuh2.con")) {
+      out.write(frame);
+    }
+    out.flush();
+    REQUIRE(out.bytes_written() == chunked.str().size());
+  }
+  std::ostringstream whole;
+  yodecon::write_multi_con(
+      whole, load_frames<yodecon::types::ConFrameFloat>(
+                 "test_data/tiny_multi_cuh2.con"));
+  REQUIRE(chunked.str() == whole.str());
+  fs::remove(conb);
+  fs::remove(con);
+}
+
+TEST_CASE("Parallel formatting matches the serial writer", "[WriteCon]") {
+  auto frame =
+      load_frames<yodecon::types::ConFrameVec>("test_data/cuh2.con").front();
+  // An empty component has a header but no atom lines
+  frame.natm_types++;
+  frame.natms_per_type.push_back(0);
+  frame.masses_per_type.push_back(1.0);
+  auto atoms = load_frames<yodecon::types::ConFrame>("test_data/cuh2.con")[0];
+
+  std::string serial;
+  yodecon::format_con(frame, serial);
+  std::string serial_atoms;
+  yodecon::format_con(atoms, serial_atoms);
+  for (const size_t nthreads : {1, 2, 4}) {
+    yodecon::helpers::parallel::ThreadPool pool{nthreads};
+    for (const size_t per_task : {1, 7, 216, 1000}) {
+      std::string parallel{"prefix"};
+      yodecon::format_con(frame, parallel, pool, per_task);
+      REQUIRE(parallel == "prefix" + serial);
+      std::string parallel_atoms;
+      yodecon::format_con(atoms, parallel_atoms, pool, per_task);
+      REQUIRE(parallel_atoms == serial_atoms);
+    }
+    std::ostringstream out;
+    yodecon::write_con(out, frame, pool);
+    REQUIRE(out.str() == serial);
+  }
+
+  yodecon::helpers::parallel::ThreadPool pool{2};
+  frame.natms_per_type[0]++;
+  std::string text;
+  REQUIRE_THROWS_AS(yodecon::format_con(frame, text, pool, 1),
+                    std::invalid_argument);
+}
@@ -13,7 +13,7 @@
 #include <fmt/ranges.h>
 #endif
 
-#ifdef WITH_ARROW
+#ifdef WITH_APACHE_ARROW
 #include <arrow/csv/api.h>
 #include <arrow/filesystem/api.h>
 #include <arrow/io/api.h>
@@ -38,10 +38,10 @@ int main(int argc, char *argv[]) {
   // const size_t natoms_per_type_linum = 8;
   // const size_t masses_per_type_linum = 9;
 
-  std::vector<std::string> fconts =
-      yodecon::helpers::file::read_con_file(filename);
+  yodecon::helpers::file::MappedFile fconts{filename};
 
-  auto tmp = yodecon::create_single_con<yodecon::types::ConFrameVec>(fconts);
+  auto tmp =
+      yodecon::create_single_con<yodecon::types::ConFrameVec>(fconts.view());
 
   //   // yodecon::types::ConFrame tmp;
 
@@ -104,7 +104,7 @@ int main(int argc, char *argv[]) {
   //           << "\n";
 #endif
 
-  // #ifdef WITH_ARROW
+  // #ifdef WITH_APACHE_ARROW
   //   // Convert to Arrow table
   //   std::shared_ptr<arrow::Table> table = yodecon::ConvertToArrowTable(tmp);
 